@@ -9,6 +9,7 @@ QT       += core gui
 TARGET = IntelliCon
 TEMPLATE = app
 
+include(engine.pri)
 
 SOURCES += main.cpp\
         gamewindow.cpp \
@@ -21,14 +22,7 @@ SOURCES += main.cpp\
     dialogabout.cpp \
     dumbplayer.cpp \
     perfectplayer.cpp \
-    perfectplayerthread.cpp \
-    boardext.cpp \
-    linethreat.cpp \
-    threatsolution.cpp \
-    movesimulator.cpp \
-    bitboard.cpp \
-    chanceplayer.cpp \
-    alphabetasearcher.cpp
+    chanceplayer.cpp
 
 HEADERS  += gamewindow.h \
     gameboard.h \
@@ -40,13 +34,7 @@ HEADERS  += gamewindow.h \
     dialogabout.h \
     dumbplayer.h \
     perfectplayer.h \
-    perfectplayerthread.h \
-    boardext.h \
-    linethreat.h \
-    movesimulator.h \
-    bitboard.h \
-    chanceplayer.h \
-    alphabetasearcher.h
+    chanceplayer.h
 
 FORMS    += gamewindow.ui \
     menuwindow.ui \
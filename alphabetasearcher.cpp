@@ -1,7 +1,15 @@
 #include "alphabetasearcher.h"
+#include "bitops.h"
 
 #include <QFile>
-#include <QDataStream>
+#include <QCoreApplication>
+
+// 93086212770453 is in binary: 0010101 0010101 0010101 0010101 0010101 0010101 0010101
+// In other words: all squares on the first, third and fifth row
+static const quint64 oddRows = Q_UINT64_C(93086212770453);
+// 186172425540906 is in binary: 0101010 0101010 0101010 0101010 0101010 0101010 0101010
+// In other words: all squares on the second, fourth and sixth row
+static const quint64 evenRows = Q_UINT64_C(186172425540906);
 
 // Public:
     // Static:
@@ -12,55 +20,170 @@
         const AlphaBetaSearcher::PositionValue AlphaBetaSearcher::DrawWin      = 4;
         const AlphaBetaSearcher::PositionValue AlphaBetaSearcher::Win          = 5;
 
+        const int AlphaBetaSearcher::WinScore       = 1000;
+        const int AlphaBetaSearcher::ProvenScore    = 900;
+
+        const int AlphaBetaSearcher::ThreatWeight   = 4;
+
+    AlphaBetaSearcher::Statistics::Statistics()
+    : nodes(0), cutoffs(0), firstMoveCutoffs(0), tableProbes(0), tableHits(0), forcedMoves(0), threatLosses(0)
+    {
+        for(int i = 0; i < 43; ++i)
+            hits[i] = 0;
+    }
+
+    double AlphaBetaSearcher::Statistics::firstMoveCutoffRate() const
+    { return cutoffs == 0 ? 0.0 : 100.0 * firstMoveCutoffs / cutoffs; }
+
+    AlphaBetaSearcher::Statistics& AlphaBetaSearcher::Statistics::operator+=(const Statistics& other)
+    {
+        nodes += other.nodes;
+        cutoffs += other.cutoffs;
+        firstMoveCutoffs += other.firstMoveCutoffs;
+        tableProbes += other.tableProbes;
+        tableHits += other.tableHits;
+        forcedMoves += other.forcedMoves;
+        threatLosses += other.threatLosses;
+        for(int i = 0; i < 43; ++i)
+            hits[i] += other.hits[i];
+        return *this;
+    }
+
     AlphaBetaSearcher::AlphaBetaSearcher(const BitBoard& board, const int& move)
-    : board(board), move(move), keepRunning(0)
-    { initHistoryHeuristic(); }
+    : board(board), move(move), keepRunning(0), depthLimit(0), horizonReached(false), threatOrdering(true), exactValues(false), distanceScores(false), nullWindow(false), rootBound(0), rootBoundIsAlpha(true)
+    {
+        initHistoryHeuristic();
+
+        // Start with an empty move table
+        for(int i = 0; i < MoveTableSize; ++i)
+        {
+            moveTablePositions[i] = 0;
+            moveTableMoves[i] = -1;
+        }
+    }
 
     void AlphaBetaSearcher::setInterruptedPointer(const bool* p)
     { keepRunning = p; }
 
+    void AlphaBetaSearcher::setDepthLimit(const int& depth)
+    { depthLimit = qMax(0, depth); }
+
+    void AlphaBetaSearcher::setThreatOrdering(const bool& enabled)
+    { threatOrdering = enabled; }
+
+    void AlphaBetaSearcher::setExactValues(const bool& enabled)
+    { exactValues = enabled; }
+
+    void AlphaBetaSearcher::setDistanceScores(const bool& enabled)
+    { distanceScores = enabled; }
+
+    void AlphaBetaSearcher::setNullWindow(const bool& enabled)
+    { nullWindow = enabled; }
+
+    void AlphaBetaSearcher::setHelperIndex(const int& index)
+    {
+        initHistoryHeuristic();
+        if(index == 0) return;
+
+        // Add a pseudo random number (0 to 7) to the history score of every square, a linear congruential generator seeded
+        // with the index is enough to give every helper its own move ordering
+        quint32 random = 2654435761u * index;
+        for(int side = 0; side < 2; ++side)
+        {
+            for(int square = 0; square < 42; ++square)
+            {
+                random = random * 1664525u + 1013904223u;
+                historyHeuristic[side][square] += random >> 29;
+            }
+        }
+    }
+
+    const AlphaBetaSearcher::Statistics& AlphaBetaSearcher::statistics() const
+    { return stats; }
+
+    void AlphaBetaSearcher::setRootBound(const QAtomicInt* bound, const bool& redAtRoot)
+    {
+        rootBound = bound;
+        rootBoundIsAlpha = redAtRoot;
+    }
+
     void AlphaBetaSearcher::run()
     {
-        const PositionValue result = alphaBeta(board.toInt(), board.redToInt(), board.yellowToInt(), Loss, Win);
+        PositionValue result;
+        if(depthLimit > 0)
+            result = iterativeDeepening();
+        else if(distanceScores)
+        {
+            // The search always reaches the end of the game, so the score is exact
+            const int score = alphaBetaDepth(MaskBoard(board.toInt()), 42, -WinScore - 1, WinScore + 1);
+            if(score > ProvenScore)
+                result = createPositionValue(Win, WinScore - score);
+            else if(score < -ProvenScore)
+                result = createPositionValue(Loss, WinScore + score);
+            else
+                result = createPositionValue(Draw, 42 - board.pieceCount());
+        }
+        else if(nullWindow)
+            result = nullWindowSearch(MaskBoard(board.toInt()));
+        else
+            result = alphaBeta(MaskBoard(board.toInt()), Loss, Win);
         if(keepRunning != 0 && *keepRunning)
-            done(move, result);
+            done(move, result, stats);
     }
 
-    AlphaBetaSearcher::PositionValue AlphaBetaSearcher::alphaBeta(const quint64& bitBoard, const quint64& redBoard, const quint64& yellowBoard, PositionValue alpha, PositionValue beta)
+    AlphaBetaSearcher::PositionValue AlphaBetaSearcher::alphaBeta(const MaskBoard& board, PositionValue alpha, PositionValue beta)
     {
-        // The amount of pieces on the board
-        const int pieceCount = BitBoard::pieceCount(redBoard, yellowBoard);
+        ++stats.nodes;
 
-        // Whose turn it is
-        const bool redToMove = pieceCount % 2 == 0;
+        // Narrow the window with the value the player at the root is already sure of, the value of this position only
+        // matters if it's better than that for the player at the root
+        if(rootBound != 0)
+        {
+            const PositionValue bound = static_cast<int>(*rootBound);
+            if(bound > alpha && bound < beta)
+            {
+                if(rootBoundIsAlpha)
+                    alpha = bound;
+                else
+                    beta = bound;
+            }
+        }
 
-        // The position that should be used as index in the database
-        const quint64 dbPosition = qMin(bitBoard, BitBoard::flip(bitBoard));
+        // The amount of pieces on the board, the board keeps track of it so it doesn't have to be counted
+        const int pieceCount = board.pieceCount();
 
-        // First we try to look up the value of this position in our database
-        if(pieceCount >= 8 && pieceCount <= 39 && (pieceCount == 8 || pieceCount % 3 == 0))
-        {
-            // The database we're going to use
-            const int dbIndex = pieceCount / 3 - 2;
+        // Whose turn it is
+        const bool redToMove = board.redToMove();
 
-            // Lock for reading
-            QReadLocker locker(AlphaBetaSearcher::posDbLockers[dbIndex]);
+        // The key of this position in the transposition table, a position and its mirror image share the key
+        const quint64 tableKey = board.canonicalKey();
 
-            // Check the database
-            if(AlphaBetaSearcher::posDb[dbIndex].contains(dbPosition))
+        // First we try to look up the value of this position in our databases
+        quint64 data = ValueUnknown;
+        int tableMove = -1;
+        if(pieceCount >= 8)
+        {
+            if(lookUp(board, tableKey, data))
             {
-                const PositionValue& posVal = AlphaBetaSearcher::posDb[dbIndex][dbPosition];
+                const PositionValue posVal = static_cast<PositionValue>(data);
                 const PositionValue val = getValue(posVal);
 
                 // If the value isn't clear because a cutoff occurred we may want to sort out which value it has
+                // The entries stored by a search by distance (see storeScore()) may not have a value at all
                 if(val == DrawWin || val == DrawLoss)
                 {
-                    // If the parent node would choose this move anyway, no further evaluation is needed
-                    if(redToMove ? val < beta : val > alpha)
+                    // The bound is enough if it already falls outside the window: at least a Draw if the window asks for
+                    // less than a Draw, or at most a Draw if it asks for more, no further evaluation is needed then
+                    // Otherwise it doesn't answer the question (e.g. a DrawWin doesn't tell whether red wins) and we search
+                    // Unless we need the exact value, since the parent would return the bound too
+                    if(!exactValues && (val == DrawWin ? beta <= Draw : alpha >= Draw))
                         return createPositionValue(val, 1 + getDepth(posVal));
                 }
-                else
+                else if(val != ValueUnknown)
                     return createPositionValue(val, 1 + getDepth(posVal));
+
+                // The position has to be searched again, the move that was best the last time is the most likely to be best again
+                tableMove = getTableMove(board, tableKey, data);
             }
         }
 
@@ -71,93 +194,45 @@
             return createPositionValue(ValueUnknown, 0);
 
         // If the board is full, it's a draw
-        if(BitBoard::isFull(bitBoard))
+        if(board.isFull())
             return createPositionValue(Draw, 0);
 
         // Check if we're not interrupted
         if(keepRunning != 0 && !*keepRunning) return createPositionValue(ValueUnknown, 0);
 
-        // Check if the opponent can win or if we have a forced move
-        // Also check which moves would make it possible for the opponent to win directly (and so we don't play them)
+        // Find the moves worth searching, if the opponent can't be stopped from winning we lose
         std::vector<int> moves;
-        moves.reserve(7);
-        const quint64& other = redToMove ? yellowBoard : redBoard;
-        for(int col = 0; col < 7; ++col)
-        {
-            if(!BitBoard::canMove(bitBoard, col)) continue;
-            const int row = BitBoard::playableRow(bitBoard, col);
-
-            // Check if the opponent can win on the square above the playable square in this column
-            const bool winOnTop = BitBoard::isWinner(other | (Q_UINT64_C(2) << (row + 7 * col)));
-
-            // Check if the opponent can win directly by playing this column
-            if(BitBoard::isWinner(other | (Q_UINT64_C(1) << (row + 7 * col))))
-            {
-                // A double threat can't be stopped
-                if(winOnTop)
-                    return createPositionValue(redToMove ? Loss : Win, 0);
-
-                // It's a forced move
-                moves.clear();
-                moves.push_back(col);
-
-                // If another forced move is found, we can't stop the opponent from winning
-                while(++col < 7)
-                {
-                    if(BitBoard::isWinner(other | (Q_UINT64_C(1) << (BitBoard::playableRow(bitBoard, col) + 7 * col))))
-                        return createPositionValue(redToMove ? Loss : Win, 0);
-                }
-
-                // Stop looking for any other moves
-                break;
-            }
-
-            // Only play this move if the opponent wouldn't win by it directly
-            if(!winOnTop)
-                moves.push_back(col);
-        }
+        if(!findMoves(board, moves))
+            return createPositionValue(redToMove ? Loss : Win, 0);
 
         // Check if we're not interrupted
         if(keepRunning != 0 && !*keepRunning) return createPositionValue(ValueUnknown, 0);
 
-        // If no moves were found, we lose
-        if(moves.empty())
-            return createPositionValue(redToMove ? Loss : Win, 0);
+        // Score the moves by the threats they create, this is used together with the history heuristic to order the moves
+        int threatScores[7];
+        scoreThreats(board, moves, threatScores);
+
+        // Try the best move of the earlier search of this position first
+        const unsigned int firstMove = moveToFront(moves, tableMove);
 
         // Find a value for each move
         const unsigned int moveCount = moves.size();
         bool valUnknown = false;
         PositionValue bestScore = redToMove ? Loss : Win;
         quint16 bestDepth = 0;
+        int bestMove = -1;
         for(unsigned int move = 0; move < moveCount; ++move)
         {
             // Check if we're not interrupted
             if(keepRunning != 0 && !*keepRunning) return createPositionValue(ValueUnknown, 0);
 
-            // Dynamically order the moves using the historyHeuristic board
-            int row = BitBoard::playableRow(bitBoard, moves[move]);
-            int bestHistory = historyHeuristic[redToMove][6 * moves[move] + row];
-            unsigned int bestMoveIndex = move;
-            for(unsigned int i = move + 1; i < moveCount; ++i)
-            {
-                const int r = BitBoard::playableRow(bitBoard, moves[i]);
-                if(historyHeuristic[redToMove][6 * moves[i] + r] > bestHistory)
-                {
-                    row = r;
-                    bestHistory = historyHeuristic[redToMove][6 * moves[i] + r];
-                    bestMoveIndex = i;
-                }
-            }
-            const int bestMoveCol = moves[bestMoveIndex];
-            for(; bestMoveIndex > move; --bestMoveIndex)
-                moves[bestMoveIndex] = moves[bestMoveIndex - 1];
-            moves[move] = bestMoveCol;
+            // Dynamically order the other moves using the historyHeuristic board and the threats
+            if(move >= firstMove)
+                selectMove(board, moves, move, threatScores);
+            const int bestMoveCol = moves[move];
 
             // Make the move
-            PositionValue posVal = alphaBeta(BitBoard::move(bitBoard, bestMoveCol, row, redToMove),
-                                             redToMove ? redBoard | (Q_UINT64_C(1) << (row + bestMoveCol * 7)) : redBoard,
-                                             redToMove ? yellowBoard : yellowBoard | (Q_UINT64_C(1) << (row + bestMoveCol * 7)),
-                                             alpha, beta);
+            PositionValue posVal = alphaBeta(board.move(bestMoveCol), alpha, beta);
             PositionValue val = getValue(posVal);
 
             // Check if we're not interrupted
@@ -167,6 +242,10 @@
                 valUnknown = true;
             else
             {
+                // If no move is better than the first one, the first one is stored as the best move
+                if(bestMove == -1)
+                    bestMove = bestMoveCol;
+
                 // Set the alpha/beta
                 if(redToMove)
                 {
@@ -174,6 +253,7 @@
                     {
                         bestScore = val;
                         bestDepth = getDepth(posVal);
+                        bestMove = bestMoveCol;
 
                         if(val > alpha)
                             alpha = val;
@@ -187,6 +267,7 @@
                     {
                         bestScore = val;
                         bestDepth = getDepth(posVal);
+                        bestMove = bestMoveCol;
 
                         if(val < beta)
                             beta = val;
@@ -198,34 +279,25 @@
                 // Check if we can make a cutoff
                 if(beta <= alpha)
                 {
-                    // Since we've cut off a part of the tree we increase the history score of this move
-                    if(move != 0)
-                    {
-                        // Punish badly chosen moves
-                        for(unsigned int i = 0; i < move; ++i)
-                            --historyHeuristic[redToMove][6 * moves[i] + BitBoard::playableRow(bitBoard, moves[i])];
+                    ++stats.cutoffs;
+                    if(move == 0)
+                        ++stats.firstMoveCutoffs;
 
-                        // Reward the good chosen move
-                        historyHeuristic[redToMove][6 * moves[move] + BitBoard::playableRow(bitBoard, moves[move])] += move;
-                    }
+                    // Since we've cut off a part of the tree we increase the history score of this move
+                    rewardMove(board, moves, move, redToMove);
 
                     // If we do a cutoff at a Draw position it may also be a Win or Loss
                     // But only if not all children have been evaluated yet
                     if(val == Draw && move != moveCount)
                         val = redToMove ? DrawWin : DrawLoss;
 
-                    // Create our result
+                    // Create our result, the move that caused the cutoff is the best move
                     const PositionValue out = createPositionValue(val, 1 + bestDepth);
 
-                    // Only store the position in the database if there are more than 8 pieces on the board
-                    // Also only store positions where red is to move (to reduce the database size)
+                    // Only store the position in the transposition table if there are more than 8 pieces on the board
                     // Also only store positions that took a lot of work
-                    if(pieceCount > 8 && pieceCount % 3 == 0 && bestDepth > 3)
-                    {
-                        AlphaBetaSearcher::posDbLockers[pieceCount / 3 - 2]->lockForWrite();
-                        AlphaBetaSearcher::posDb[pieceCount / 3 - 2][dbPosition] = out;
-                        AlphaBetaSearcher::posDbLockers[pieceCount / 3 - 2]->unlock();
-                    }
+                    if(pieceCount > 8 && bestDepth > 3)
+                        storePosition(board, tableKey, out, bestMoveCol);
 
                     return out;
                 }
@@ -242,55 +314,396 @@
         // Create our result
         const PositionValue out = createPositionValue(bestScore, 1 + bestDepth);
 
-        // Only store the position in the database if there are more than 8 pieces on the board
+        // Only store the position in the transposition table if there are more than 8 pieces on the board
         // Also only store positions that took a lot of work
-        if(pieceCount > 8 && pieceCount % 3 == 0 && bestDepth > 3)
+        if(pieceCount > 8 && bestDepth > 3)
+            storePosition(board, tableKey, out, bestMove);
+
+        return out;
+    }
+
+    AlphaBetaSearcher::PositionValue AlphaBetaSearcher::nullWindowSearch(const MaskBoard& board)
+    {
+        // If the player at the root is already sure of a Draw, only the question whether this move is better matters
+        // The root bound narrows the full window to that question anyway, so the other search would be wasted
+        if(rootBound != 0)
         {
-            AlphaBetaSearcher::posDbLockers[pieceCount / 3 - 2]->lockForWrite();
-            AlphaBetaSearcher::posDb[pieceCount / 3 - 2][dbPosition] = out;
-            AlphaBetaSearcher::posDbLockers[pieceCount / 3 - 2]->unlock();
+            const PositionValue bound = static_cast<int>(*rootBound);
+            if(rootBoundIsAlpha ? bound >= Draw : bound <= Draw)
+                return rootBoundIsAlpha ? alphaBeta(board, Draw, Win) : alphaBeta(board, Loss, Draw);
         }
 
-        return out;
+        // Does red do better than a Loss?
+        // A Loss or a Win is the answer, a Draw or a DrawWin means red draws at least
+        const PositionValue first = alphaBeta(board, Loss, Draw);
+        const PositionValue firstVal = getValue(first);
+        if(firstVal != Draw && firstVal != DrawWin)
+            return first;
+
+        // Red draws at least, does red win?
+        // The first search stored the position itself as DrawWin, that bound doesn't answer this question so it isn't used (see alphaBeta())
+        const PositionValue second = alphaBeta(board, Draw, Win);
+        const PositionValue secondVal = getValue(second);
+        if(secondVal == Win || secondVal == DrawWin || secondVal == ValueUnknown)
+            return second;
+
+        // Red draws, the depth is that of the deepest search
+        return createPositionValue(Draw, qMax(getDepth(first), getDepth(second)));
+    }
+
+    int AlphaBetaSearcher::alphaBetaDepth(const MaskBoard& board, const int& depth, int alpha, int beta)
+    {
+        ++stats.nodes;
+
+        // The amount of pieces on the board, the board keeps track of it so it doesn't have to be counted
+        const int pieceCount = board.pieceCount();
+
+        // Whose turn it is
+        const bool redToMove = board.redToMove();
+
+        // The key of this position in the transposition table, a position and its mirror image share the key
+        const quint64 tableKey = board.canonicalKey();
+
+        // If no position at the horizon can be reached, every score is the exact distance to the end of the game
+        const bool exactScores = depth >= 42 - pieceCount;
+
+        // Use the values of the position databases and the transposition table, these are always proven
+        // In contrast to alphaBeta() we keep searching if an 8-ply position isn't in the database
+        quint64 data = ValueUnknown;
+        int tableMove = -1;
+        if(pieceCount >= 8)
+        {
+            if(lookUp(board, tableKey, data))
+            {
+                if(exactScores)
+                {
+                    // Most entries only tell between which scores the exact score is, the window is narrowed with them
+                    int lower, upper;
+                    tableScoreBounds(data, 42 - pieceCount, lower, upper);
+                    if(lower == upper)  return lower;
+                    if(lower >= beta)   return lower;
+                    if(upper <= alpha)  return upper;
+                    alpha = qMax(alpha, lower - 1);
+                    beta = qMin(beta, upper + 1);
+                }
+                else
+                {
+                    // Only an exact score is the distance to the end of the game, the depth of the other entries is how deep
+                    // the search went, so a won position without an exact score only scores at least like the slowest win
+                    // The window isn't narrowed, since the scores of the positions at the horizon aren't proven
+                    int lower, upper;
+                    tableScoreBounds(data, 42 - pieceCount, lower, upper);
+                    if(lower == upper)  return lower;
+                    if(lower >= beta)   return lower;
+                    if(upper <= alpha)  return upper;
+                }
+                tableMove = getTableMove(board, tableKey, data);
+            }
+        }
+
+        // If the board is full, it's a draw
+        if(board.isFull())
+            return 0;
+
+        // Check if we're not interrupted
+        if(keepRunning != 0 && !*keepRunning) return 0;
+
+        // Find the moves worth searching, if the opponent can't be stopped from winning we lose
+        // The game ends two plies later: after our move, the opponent completes a group with his next move
+        std::vector<int> moves;
+        if(!findMoves(board, moves))
+            return redToMove ? 2 - WinScore : WinScore - 2;
+
+        // At the horizon we have to guess the score
+        if(depth <= 0)
+        {
+            horizonReached = true;
+            return evaluate(board.redToInt(), board.yellowToInt());
+        }
+
+        // Narrow the window with the scores that are possible at all
+        if(exactScores)
+        {
+            // A game is won or lost before the board is full, so only a draw lies between the slowest win and the slowest loss
+            // The window isn't moved across the gap if the other side of the window lies in it, since it would end up empty
+            const int slowestWin = WinScore - (42 - pieceCount);
+            if(alpha >= 0 && alpha < slowestWin && beta > slowestWin)
+                alpha = slowestWin - 1;
+            if(beta <= 0 && beta > -slowestWin && alpha < -slowestWin)
+                beta = 1 - slowestWin;
+
+            // The player to move wins at the earliest when the opponent is to move, and the opponent can't win before his next move
+            const int maxScore = redToMove ? WinScore - 1 : WinScore - 2;
+            const int minScore = redToMove ? 2 - WinScore : 1 - WinScore;
+            if(maxScore <= alpha)   return maxScore;
+            if(minScore >= beta)    return minScore;
+            beta = qMin(beta, maxScore + 1);
+            alpha = qMax(alpha, minScore - 1);
+        }
+
+        // The window we search with, needed to know whether the result is proven
+        const int alphaOrig = alpha;
+        const int betaOrig = beta;
+
+        // Try the best move of an earlier iteration first, or else the best move stored in the transposition table
+        const quint64 key = board.key();
+        const int tableIndex = moveTableIndex(key);
+        unsigned int firstMove = 0;
+        if(moveTablePositions[tableIndex] == key)
+            firstMove = moveToFront(moves, moveTableMoves[tableIndex]);
+        if(firstMove == 0)
+            firstMove = moveToFront(moves, tableMove);
+
+        // Score the moves by the threats they create, this is used together with the history heuristic to order the moves
+        int threatScores[7];
+        scoreThreats(board, moves, threatScores);
+
+        // Find a score for each move
+        // Scores of won positions are one ply further away from the win in this position, so the window and the results are converted
+        const unsigned int moveCount = moves.size();
+        int bestScore = redToMove ? -WinScore - 1 : WinScore + 1;
+        int bestMove = -1;
+        for(unsigned int move = 0; move < moveCount; ++move)
+        {
+            // Check if we're not interrupted
+            if(keepRunning != 0 && !*keepRunning) return 0;
+
+            // Dynamically order the other moves using the historyHeuristic board and the threats
+            if(move >= firstMove)
+                selectMove(board, moves, move, threatScores);
+            const int col = moves[move];
+
+            // Make the move
+            const MaskBoard newBoard = board.move(col);
+            const int childAlpha = alpha > ProvenScore ? alpha + 1 : (alpha < -ProvenScore ? alpha - 1 : alpha);
+            const int childBeta = beta > ProvenScore ? beta + 1 : (beta < -ProvenScore ? beta - 1 : beta);
+
+            // The first move is searched with the full window, the other moves are only tested with a null window
+            // Only if a move turns out to be better than the best move so far it's searched again with the full window
+            int score;
+            if(move == 0)
+                score = alphaBetaDepth(newBoard, depth - 1, childAlpha, childBeta);
+            else
+            {
+                score = redToMove ? alphaBetaDepth(newBoard, depth - 1, childAlpha, childAlpha + 1)
+                                  : alphaBetaDepth(newBoard, depth - 1, childBeta - 1, childBeta);
+                if(score > childAlpha && score < childBeta)
+                    score = alphaBetaDepth(newBoard, depth - 1, childAlpha, childBeta);
+            }
+            if(score > ProvenScore)         --score;
+            else if(score < -ProvenScore)   ++score;
+
+            // Check if we're not interrupted
+            if(keepRunning != 0 && !*keepRunning) return 0;
+
+            // Set the alpha/beta
+            if(redToMove ? score > bestScore : score < bestScore)
+            {
+                bestScore = score;
+                bestMove = col;
+                moveTablePositions[tableIndex] = key;
+                moveTableMoves[tableIndex] = col;
+
+                if(redToMove && score > alpha)
+                    alpha = score;
+                else if(!redToMove && score < beta)
+                    beta = score;
+            }
+
+            // Check if we can make a cutoff
+            if(beta <= alpha)
+            {
+                ++stats.cutoffs;
+                if(move == 0)
+                    ++stats.firstMoveCutoffs;
+
+                rewardMove(board, moves, move, redToMove);
+                break;
+            }
+        }
+
+        // Exact scores are stored together with the kind of bound they are
+        if(pieceCount > 8 && exactScores)
+            storeScore(board, tableKey, bestScore, bestScore <= alphaOrig ? UpperScore : (bestScore >= betaOrig ? LowerScore : ExactScore), bestMove);
+        // A won score is proven if it's not an upper bound, a lost score if it's not a lower bound
+        // Only store proven positions in the transposition table, so the values can be used by alphaBeta() too
+        else if(pieceCount > 8)
+        {
+            const quint16 plies = WinScore - qAbs(bestScore);
+            if(bestScore > ProvenScore && bestScore > alphaOrig && plies > 3)
+                AlphaBetaSearcher::transpositionTable.store(tableKey, createTableData(board, tableKey, createPositionValue(Win, plies), bestMove), plies);
+            else if(bestScore < -ProvenScore && bestScore < betaOrig && plies > 3)
+                AlphaBetaSearcher::transpositionTable.store(tableKey, createTableData(board, tableKey, createPositionValue(Loss, plies), bestMove), plies);
+        }
+
+        return bestScore;
     }
 
     /// Static functions:
     void AlphaBetaSearcher::loadPositionDatabase()
     {
         // Acquire a write lock on the the database
-        QWriteLocker locker(AlphaBetaSearcher::posDbLockers[0]);
+        QWriteLocker locker(&AlphaBetaSearcher::posDbLocker);
+        if(AlphaBetaSearcher::posDb.isLoaded()) return;
 
-        // Reserve the exact size needed for the database
-        AlphaBetaSearcher::posDb[0].reserve(67557);
+        // Continue with the positions found by earlier processes if the environment variable INTELLICON_POSITION_CACHE is set
+        const QString cacheName = QString::fromLocal8Bit(qgetenv("INTELLICON_POSITION_CACHE"));
+        if(!cacheName.isEmpty() && !AlphaBetaSearcher::positionCache.isOpen())
+            openPositionCache(cacheName);
 
-        // The filenames
-        const QString filenames[] = {":/data/win-pos.db", ":/data/draw-pos.db", ":/data/loss-pos.db"};
+        // Prefer the packed file, since it's mapped in memory nothing has to be parsed
+        // If the environment variable INTELLICON_POSITION_DB isn't set, we look for positions.pdb next to the executable
+        QString fileName = AlphaBetaSearcher::posDbFileName;
+        if(fileName.isEmpty())
+            fileName = QString::fromLocal8Bit(qgetenv("INTELLICON_POSITION_DB"));
+        if(fileName.isEmpty() && QCoreApplication::instance() != 0)
+            fileName = QCoreApplication::applicationDirPath() + "/positions.pdb";
 
-        // Read each file
-        for(int i = 0; i < 3; ++i)
+        // Also use the opening books next to the executable, if they've been generated
+        if(QCoreApplication::instance() != 0)
         {
-            // Open a stream for the file
-            QFile file(filenames[i]);
-            file.open(QIODevice::ReadOnly);
-            QDataStream stream(&file);
-
-            // Read all positions from the database
-            quint64 dbPosition = 0;
-            while(!stream.atEnd())
+            const int pieces[] = {10, 12};
+            for(int i = 0; i < 2; ++i)
             {
-                stream>>dbPosition;
-                AlphaBetaSearcher::posDb[0][dbPosition] = (i == 0 ? Win : (i == 1 ? Draw : Loss));
+                const QString bookName = QCoreApplication::applicationDirPath() + QString("/positions-%1.pdb").arg(pieces[i]);
+                if(!AlphaBetaSearcher::openingBooks[i].isLoaded() && QFile::exists(bookName))
+                    AlphaBetaSearcher::openingBooks[i].map(bookName);
             }
         }
+
+        if(!fileName.isEmpty() && QFile::exists(fileName) && AlphaBetaSearcher::posDb.map(fileName))
+            return;
+
+        // Otherwise read the positions from the resources
+        AlphaBetaSearcher::posDb.loadFiles(":/data/");
     }
 
     bool AlphaBetaSearcher::positionDatabaseLoaded()
     {
         // Acquire a read lock on the the database
-        QReadLocker locker(AlphaBetaSearcher::posDbLockers[0]);
+        QReadLocker locker(&AlphaBetaSearcher::posDbLocker);
 
         // Return whether we've loaded the database already
-        return !AlphaBetaSearcher::posDb[0].empty();
+        return AlphaBetaSearcher::posDb.isLoaded();
+    }
+
+    void AlphaBetaSearcher::setPositionDatabaseFile(const QString& fileName)
+    {
+        QWriteLocker locker(&AlphaBetaSearcher::posDbLocker);
+        AlphaBetaSearcher::posDbFileName = fileName;
+    }
+
+    bool AlphaBetaSearcher::savePositionDatabase(const QString& fileName)
+    {
+        // Make sure the database is loaded
+        if(!positionDatabaseLoaded())
+            loadPositionDatabase();
+
+        QReadLocker locker(&AlphaBetaSearcher::posDbLocker);
+        return AlphaBetaSearcher::posDb.save(fileName);
+    }
+
+    bool AlphaBetaSearcher::loadOpeningBook(const int& pieces, const QString& fileName)
+    {
+        if(pieces != 10 && pieces != 12) return false;
+
+        // The file is either a packed file or the prefix of the win, draw and loss files
+        PositionDatabase& book = AlphaBetaSearcher::openingBooks[pieces == 10 ? 0 : 1];
+        return book.map(fileName) || book.loadFiles(fileName);
+    }
+
+    bool AlphaBetaSearcher::openingBookLoaded(const int& pieces)
+    { return (pieces == 10 || pieces == 12) && AlphaBetaSearcher::openingBooks[pieces == 10 ? 0 : 1].isLoaded(); }
+
+    void AlphaBetaSearcher::unloadOpeningBook(const int& pieces)
+    {
+        if(pieces == 10 || pieces == 12)
+            AlphaBetaSearcher::openingBooks[pieces == 10 ? 0 : 1].clear();
+    }
+
+    void AlphaBetaSearcher::setTranspositionTableSize(const int& megabytes)
+    { AlphaBetaSearcher::transpositionTable.resize(megabytes); }
+
+    void AlphaBetaSearcher::clearTranspositionTable()
+    { AlphaBetaSearcher::transpositionTable.clear(); }
+
+    bool AlphaBetaSearcher::openPositionCache(const QString& fileName, const int& maxEntries)
+    {
+        std::vector<PositionCache::Entry> entries;
+        if(!AlphaBetaSearcher::positionCache.open(fileName, maxEntries, entries))
+            return false;
+
+        // Put the positions found by earlier processes in the transposition table
+        for(std::vector<PositionCache::Entry>::const_iterator pos = entries.begin(); pos != entries.end(); ++pos)
+            AlphaBetaSearcher::transpositionTable.store(MaskBoard(pos->position).canonicalKey(), pos->value, pos->priority);
+        return true;
+    }
+
+    bool AlphaBetaSearcher::flushPositionCache()
+    { return AlphaBetaSearcher::positionCache.flush(); }
+
+    int AlphaBetaSearcher::positionCacheSize()
+    { return AlphaBetaSearcher::positionCache.size(); }
+
+    AlphaBetaSearcher::PositionValue AlphaBetaSearcher::rootMoveValue(const QAtomicInt& bound, const PositionValue& val, const bool& redAtRoot)
+    {
+        // With red at the root the bound is a lower bound: a value below it is an upper bound, which is exact for a Loss,
+        // and a value above it is exact, only a value equal to it is ambiguous (the other way around with yellow at the root)
+        // Only a Draw narrows the window, a Loss or Win bound is the full window
+        const PositionValue sure = static_cast<int>(bound);
+        if(getValue(val) == Draw && sure == Draw)
+            return createPositionValue(redAtRoot ? DrawLoss : DrawWin, getDepth(val));
+        return val;
+    }
+
+    void AlphaBetaSearcher::raiseRootBound(QAtomicInt& bound, const PositionValue& val, const bool& redAtRoot)
+    {
+        // Only use what the player at the root is sure of: a DrawWin is at least a Draw for red, a DrawLoss at least a Draw for yellow
+        const PositionValue value = getValue(val);
+        PositionValue sure;
+        if(redAtRoot)
+            sure = value == Win ? Win : (value == Draw || value == DrawWin ? Draw : Loss);
+        else
+            sure = value == Loss ? Loss : (value == Draw || value == DrawLoss ? Draw : Win);
+
+        // Other threads may raise the bound at the same time, so only replace the value we've compared with
+        while(true)
+        {
+            const int current = bound;
+            if(redAtRoot ? sure <= current : sure >= current) return;
+            if(bound.testAndSetOrdered(current, sure)) return;
+        }
+    }
+
+    std::vector<int> AlphaBetaSearcher::principalVariation(const BitBoard& board, bool& complete)
+    {
+        std::vector<int> moves;
+        MaskBoard current(board.toInt());
+        complete = true;
+        while(!current.isFull() && !BitBoard::isWinner(current.opponent()))
+        {
+            complete = false;
+            const quint64 tableKey = current.canonicalKey();
+            quint64 data;
+            if(!AlphaBetaSearcher::transpositionTable.probe(tableKey, data))
+                break;
+
+            // A bound doesn't tell which move is best, the entries stored by storeScore() are only exact if their score is
+            const PositionValue val = getValue(static_cast<PositionValue>(data));
+            const ScoreBound bound = static_cast<ScoreBound>((data >> 19) & 3);
+            if(bound == NoScore ? val != Loss && val != Draw && val != Win : bound != ExactScore)
+                break;
+
+            // The positions put in the table from the cache file have no best move
+            const int col = getTableMove(current, tableKey, data);
+            if(col == -1 || !current.canMove(col))
+                break;
+
+            moves.push_back(col);
+            current.play(col);
+            complete = true;
+        }
+        return moves;
     }
 
     AlphaBetaSearcher::PositionValue AlphaBetaSearcher::createPositionValue(const PositionValue& val, const quint16& depth)
@@ -315,20 +728,21 @@
 
 // Private:
     // Static:
-        // Since only the positions with 8, 9, 12, 15, 18, 21, 24, 27, 30, 33, 36 or 39 pieces will be saved we only need 12 QHash maps
-        // This is because only positions which are a multiple of 3 are saved, and only if their search depth was greater than 3 (therefore, no positions with 42 pieces will be saved)
-        // Also all positions with 8 pieces will be saved (they will be read from the database)
-        // The index of each QHash map is calculated as follows: numberOfPieces / 3 - 2
-        QHash<quint64, AlphaBetaSearcher::PositionValue> AlphaBetaSearcher::posDb[] =
-        {
-            QHash<quint64, AlphaBetaSearcher::PositionValue>(), QHash<quint64, AlphaBetaSearcher::PositionValue>(), QHash<quint64, AlphaBetaSearcher::PositionValue>(),
-            QHash<quint64, AlphaBetaSearcher::PositionValue>(), QHash<quint64, AlphaBetaSearcher::PositionValue>(), QHash<quint64, AlphaBetaSearcher::PositionValue>(),
-            QHash<quint64, AlphaBetaSearcher::PositionValue>(), QHash<quint64, AlphaBetaSearcher::PositionValue>(), QHash<quint64, AlphaBetaSearcher::PositionValue>(),
-            QHash<quint64, AlphaBetaSearcher::PositionValue>(), QHash<quint64, AlphaBetaSearcher::PositionValue>(), QHash<quint64, AlphaBetaSearcher::PositionValue>()
-        };
+        // The 8-ply positions, these are read from the database by loadPositionDatabase()
+        PositionDatabase AlphaBetaSearcher::posDb;
+        // The packed file to map by loadPositionDatabase(), if it's empty the default location is used
+        QString AlphaBetaSearcher::posDbFileName;
+
+        // The 10-ply and 12-ply positions, these are only available if they're loaded by loadOpeningBook()
+        PositionDatabase AlphaBetaSearcher::openingBooks[2];
 
-        // The locks for knownPositions, every QReadWriteLock in this array represents the lock for using the QHash with the same index
-        AlphaBetaSearcher::PositionDatabaseLockers AlphaBetaSearcher::posDbLockers;
+        // The lock for posDb, it's only needed while the database is being loaded
+        QReadWriteLock AlphaBetaSearcher::posDbLocker;
+
+        // The positions found during the search, by default 64 MB is used
+        TranspositionTable AlphaBetaSearcher::transpositionTable(64);
+        // The file the positions stored in the transposition table are written to, if it's opened
+        PositionCache AlphaBetaSearcher::positionCache;
 
     void AlphaBetaSearcher::initHistoryHeuristic()
     {
@@ -353,18 +767,306 @@
         }
     }
 
-    // PositionDatabaseLockers class
-        AlphaBetaSearcher::PositionDatabaseLockers::PositionDatabaseLockers()
+    bool AlphaBetaSearcher::lookUp(const MaskBoard& board, const quint64& tableKey, quint64& data)
+    {
+        // Positions with 8 pieces are looked up in the position database, positions with 10 or 12 pieces in the opening books
+        // Note that the databases are never written to while searchers are running, so we don't need to lock them
+        const int pieceCount = board.pieceCount();
+        bool found = false;
+        if(pieceCount == 8)
+            found = AlphaBetaSearcher::posDb.probe(databaseKey(board), data);
+        else if(pieceCount == 10 || pieceCount == 12)
+            found = AlphaBetaSearcher::openingBooks[pieceCount == 10 ? 0 : 1].probe(databaseKey(board), data);
+
+        // All other positions with more than 8 pieces (and the positions that are missing from the books) may be in the transposition table
+        if(!found && pieceCount > 8)
+        {
+            ++stats.tableProbes;
+            found = AlphaBetaSearcher::transpositionTable.probe(tableKey, data);
+            if(found)
+                ++stats.tableHits;
+        }
+
+        if(found)
+            ++stats.hits[pieceCount];
+        return found;
+    }
+
+    void AlphaBetaSearcher::storePosition(const MaskBoard& board, const quint64& tableKey, const PositionValue& value, const int& bestMove)
+    {
+        AlphaBetaSearcher::transpositionTable.store(tableKey, createTableData(board, tableKey, value, bestMove), getDepth(value));
+
+        // The cache file uses the same keys as the position databases, so it doesn't depend on the keys of the transposition table
+        if(AlphaBetaSearcher::positionCache.isOpen())
+            AlphaBetaSearcher::positionCache.record(databaseKey(board), value, getDepth(value));
+    }
+
+    quint64 AlphaBetaSearcher::databaseKey(const MaskBoard& board)
+    {
+        const quint64 bitBoard = board.toInt();
+        return qMin(bitBoard, BitBoard::flip(bitBoard));
+    }
+
+    void AlphaBetaSearcher::storeScore(const MaskBoard& board, const quint64& tableKey, const int& score, const ScoreBound& bound, const int& bestMove)
+    {
+        // A bound on the score doesn't always tell whether the position is won, drawn or lost, the value is unknown then
+        // The depth of a drawn position is the amount of empty squares, since the search went that deep
+        PositionValue value;
+        if(score > ProvenScore)
+            value = createPositionValue(bound == UpperScore ? ValueUnknown : Win, WinScore - score);
+        else if(score < -ProvenScore)
+            value = createPositionValue(bound == LowerScore ? ValueUnknown : Loss, WinScore + score);
+        else
+            value = createPositionValue(bound == ExactScore ? Draw : (bound == LowerScore ? DrawWin : DrawLoss), 42 - board.pieceCount());
+
+        // Only store positions that took a lot of work
+        if(getDepth(value) <= 3)
+            return;
+
+        // The 2 bits after the best move are the kind of score, the next 11 bits are the score plus 1024
+        const quint64 data = createTableData(board, tableKey, value, bestMove) | static_cast<quint64>(bound) << 19 | static_cast<quint64>(score + 1024) << 21;
+        AlphaBetaSearcher::transpositionTable.store(tableKey, data, getDepth(value));
+
+        // The cache file only keeps the value
+        if(AlphaBetaSearcher::positionCache.isOpen() && getValue(value) != ValueUnknown)
+            AlphaBetaSearcher::positionCache.record(databaseKey(board), value, getDepth(value));
+    }
+
+    quint64 AlphaBetaSearcher::createTableData(const MaskBoard& board, const quint64& tableKey, const PositionValue& value, const int& bestMove)
+    {
+        // The lowest 16 bits are the PositionValue, the next 3 bits are the best move plus one (0 if there is no best move)
+        // The move is stored for the board the key was taken from, so it's mirrored if the board is the mirror image of that board
+        if(bestMove == -1)
+            return value;
+        const int col = board.key() == tableKey ? bestMove : 6 - bestMove;
+        return value | static_cast<quint64>(col + 1) << 16;
+    }
+
+    void AlphaBetaSearcher::tableScoreBounds(const quint64& data, const int& remaining, int& lower, int& upper)
+    {
+        const PositionValue posVal = static_cast<PositionValue>(data);
+        const PositionValue val = getValue(posVal);
+
+        // From the value alone, we only know the game is won or lost before the board is full
+        const int slowestWin = WinScore - remaining;
+        lower = -WinScore - 1;
+        upper = WinScore + 1;
+        if(val == Win)              lower = slowestWin;
+        else if(val == Loss)        upper = -slowestWin;
+        else if(val == Draw)        lower = upper = 0;
+        else if(val == DrawWin)     lower = 0;
+        else if(val == DrawLoss)    upper = 0;
+
+        // The entries stored by storeScore() know the score too
+        const ScoreBound bound = static_cast<ScoreBound>((data >> 19) & 3);
+        const int score = static_cast<int>((data >> 21) & 2047) - 1024;
+        if(bound == ExactScore)
+            lower = upper = score;
+        else if(bound == LowerScore)
+            lower = qMax(lower, score);
+        else if(bound == UpperScore)
+            upper = qMin(upper, score);
+    }
+
+    int AlphaBetaSearcher::getTableMove(const MaskBoard& board, const quint64& tableKey, const quint64& data)
+    {
+        // The position databases and the cache file only store a PositionValue, so there is no move in their data
+        const int col = static_cast<int>((data >> 16) & 7) - 1;
+        if(col == -1)
+            return -1;
+        return board.key() == tableKey ? col : 6 - col;
+    }
+
+    int AlphaBetaSearcher::moveTableIndex(const quint64& key)
+    { return (key * Q_UINT64_C(0x9E3779B97F4A7C15)) >> 52; }
+
+    unsigned int AlphaBetaSearcher::moveToFront(std::vector<int>& moves, const int& col)
+    {
+        if(col == -1)
+            return 0;
+
+        // The move is only tried if it's one of the moves worth searching
+        for(unsigned int i = 0; i < moves.size(); ++i)
+        {
+            if(moves[i] == col)
+            {
+                moves[i] = moves[0];
+                moves[0] = col;
+                return 1;
+            }
+        }
+        return 0;
+    }
+
+    AlphaBetaSearcher::PositionValue AlphaBetaSearcher::iterativeDeepening()
+    {
+        // Half the width of the window around the score of the previous iteration
+        const int aspirationWindow = 4;
+
+        int score = 0;
+        for(int depth = 1; depth <= depthLimit; ++depth)
+        {
+            // Search with a small window around the score of the previous iteration
+            // If the score falls outside the window, search again with the window opened on that side
+            int alpha = depth == 1 ? -WinScore - 1 : score - aspirationWindow;
+            int beta = depth == 1 ? WinScore + 1 : score + aspirationWindow;
+            horizonReached = false;
+            while(true)
+            {
+                score = alphaBetaDepth(MaskBoard(board.toInt()), depth, alpha, beta);
+
+                // Check if we're not interrupted
+                if(keepRunning != 0 && !*keepRunning) return createPositionValue(ValueUnknown, 0);
+
+                if(score <= alpha)
+                    alpha = -WinScore - 1;
+                else if(score >= beta)
+                    beta = WinScore + 1;
+                else
+                    break;
+            }
+            iterationDone(move, depth, score);
+
+            // Searching deeper won't change a proven win or loss
+            if(score > ProvenScore)
+                return createPositionValue(Win, WinScore - score);
+            if(score < -ProvenScore)
+                return createPositionValue(Loss, WinScore + score);
+
+            // If no position at the horizon was evaluated, the whole tree has been searched and it's a draw
+            if(!horizonReached)
+                return createPositionValue(Draw, depth);
+        }
+
+        // We didn't search deep enough to know the value
+        return createPositionValue(ValueUnknown, depthLimit);
+    }
+
+    bool AlphaBetaSearcher::findMoves(const MaskBoard& board, std::vector<int>& moves)
+    {
+        // The pieces of the player that isn't to move
+        const quint64 other = board.opponent();
+
+        // Check if the opponent can win or if we have a forced move
+        // Also check which moves would make it possible for the opponent to win directly (and so we don't play them)
+        moves.reserve(7);
+        for(int col = 0; col < 7; ++col)
+        {
+            const quint64 square = board.playableSquare(col);
+            if(square == 0) continue;
+
+            // Check if the opponent can win on the square above the playable square in this column
+            const bool winOnTop = BitBoard::isWinner(other | (square << 1));
+
+            // Check if the opponent can win directly by playing this column
+            if(BitBoard::isWinner(other | square))
+            {
+                // A double threat can't be stopped
+                if(winOnTop)
+                {
+                    ++stats.threatLosses;
+                    return false;
+                }
+
+                // It's a forced move
+                moves.clear();
+                moves.push_back(col);
+
+                // If another forced move is found, we can't stop the opponent from winning
+                while(++col < 7)
+                {
+                    if(BitBoard::isWinner(other | board.playableSquare(col)))
+                    {
+                        ++stats.threatLosses;
+                        return false;
+                    }
+                }
+
+                // Stop looking for any other moves
+                ++stats.forcedMoves;
+                return true;
+            }
+
+            // Only play this move if the opponent wouldn't win by it directly
+            if(!winOnTop)
+                moves.push_back(col);
+        }
+
+        // If no moves were found, we lose
+        if(moves.empty())
+        {
+            ++stats.threatLosses;
+            return false;
+        }
+
+        return true;
+    }
+
+    void AlphaBetaSearcher::scoreThreats(const MaskBoard& board, const std::vector<int>& moves, int* scores) const
+    {
+        // A forced move doesn't need to be ordered
+        if(!threatOrdering || moves.size() < 2)
+        {
+            for(unsigned int i = 0; i < moves.size(); ++i)
+                scores[moves[i]] = 0;
+            return;
+        }
+
+        // Red profits most from threats on odd rows, yellow from threats on even rows (see BoardExt::hasOddThreat())
+        // So a threat on the right row counts twice
+        const quint64 goodRows = board.redToMove() ? oddRows : evenRows;
+        const quint64 own = board.current();
+        const quint64 occupied = board.mask();
+        for(unsigned int i = 0; i < moves.size(); ++i)
         {
-            for(int i = 0; i < 12; ++i)
-                lockers[i] = new QReadWriteLock();
+            const quint64 square = board.playableSquare(moves[i]);
+            const quint64 threats = BitBoard::threatSquares(own | square, occupied | square);
+            scores[moves[i]] = ThreatWeight * (2 * BitOps::popcount(threats & goodRows) + BitOps::popcount(threats & ~goodRows));
         }
+    }
 
-        AlphaBetaSearcher::PositionDatabaseLockers::~PositionDatabaseLockers()
+    void AlphaBetaSearcher::selectMove(const MaskBoard& board, std::vector<int>& moves, const unsigned int& move, const int* threatScores) const
+    {
+        const bool redToMove = board.redToMove();
+        int bestScore = historyHeuristic[redToMove][6 * moves[move] + board.playableRow(moves[move])] + threatScores[moves[move]];
+        unsigned int bestMoveIndex = move;
+        for(unsigned int i = move + 1; i < moves.size(); ++i)
         {
-            for(int i = 0; i < 12; ++i)
-                delete lockers[i];
+            const int score = historyHeuristic[redToMove][6 * moves[i] + board.playableRow(moves[i])] + threatScores[moves[i]];
+            if(score > bestScore)
+            {
+                bestScore = score;
+                bestMoveIndex = i;
+            }
         }
 
-        QReadWriteLock* AlphaBetaSearcher::PositionDatabaseLockers::operator[](const unsigned int& n)
-        { return lockers[n]; }
+        // Shift the moves in between one place, so the order of the other moves stays the same
+        const int bestMoveCol = moves[bestMoveIndex];
+        for(; bestMoveIndex > move; --bestMoveIndex)
+            moves[bestMoveIndex] = moves[bestMoveIndex - 1];
+        moves[move] = bestMoveCol;
+    }
+
+    void AlphaBetaSearcher::rewardMove(const MaskBoard& board, const std::vector<int>& moves, const unsigned int& move, const bool& redToMove)
+    {
+        // If the first move caused the cutoff, the ordering was right already
+        if(move == 0) return;
+
+        // Punish badly chosen moves
+        for(unsigned int i = 0; i < move; ++i)
+            --historyHeuristic[redToMove][6 * moves[i] + board.playableRow(moves[i])];
+
+        // Reward the good chosen move
+        historyHeuristic[redToMove][6 * moves[move] + board.playableRow(moves[move])] += move;
+    }
+
+    int AlphaBetaSearcher::evaluate(const quint64& redBoard, const quint64& yellowBoard)
+    {
+        const quint64 occupied = redBoard | yellowBoard;
+        const quint64 redThreats = BitBoard::threatSquares(redBoard, occupied);
+        const quint64 yellowThreats = BitBoard::threatSquares(yellowBoard, occupied);
+
+        // A threat on the right row counts three times as much as a threat on the wrong row
+        return 3 * BitOps::popcount(redThreats & oddRows) + BitOps::popcount(redThreats & evenRows)
+             - 3 * BitOps::popcount(yellowThreats & evenRows) - BitOps::popcount(yellowThreats & oddRows);
+    }
@@ -4,7 +4,14 @@
 #include <QObject>
 #include <QRunnable>
 #include <QReadWriteLock>
+#include <QAtomicInt>
+#include <QMetaType>
+#include <vector>
 #include "bitboard.h"
+#include "maskboard.h"
+#include "transpositiontable.h"
+#include "positiondatabase.h"
+#include "positioncache.h"
 
 class AlphaBetaSearcher : public QObject, public QRunnable
 {
@@ -26,21 +33,139 @@ class AlphaBetaSearcher : public QObject, public QRunnable
         static const PositionValue DrawWin;
         static const PositionValue Win;
 
+        /// Scores used by the depth limited search, always from red's point of view
+        //  A position in which red wins scores WinScore minus the amount of plies it takes (so a faster win scores higher)
+        //  Heuristic scores of positions at the horizon always lie between -ProvenScore and ProvenScore
+        static const int WinScore;
+        static const int ProvenScore;
+
+        // The score of a threat (an empty square that completes a group) created by a move, used to order the moves
+        // It's added to the history score of the move, a threat on the row that's good for the player to move counts twice
+        static const int ThreatWeight;
+
+        /// Statistics about the search of one searcher
+        /// Every searcher counts in its own instance, so no synchronisation is needed while searching
+        struct Statistics
+        {
+            quint64 nodes;              // The amount of positions visited
+            quint64 cutoffs;            // The amount of positions in which a cutoff occurred
+            quint64 firstMoveCutoffs;   // The amount of cutoffs caused by the first move that was tried
+            quint64 tableProbes;        // The amount of times the transposition table was consulted
+            quint64 tableHits;          // The amount of times the position was found in the transposition table
+            quint64 forcedMoves;        // The amount of positions in which only one move had to be searched because the opponent threatened to win
+            quint64 threatLosses;       // The amount of positions that were lost without searching because of a double threat (or no playable moves)
+            quint64 hits[43];           // The amount of times a position with the given amount of pieces was found in the position database (8 pieces) or the transposition table
+
+            Statistics();
+
+            // Returns the percentage of cutoffs that were caused by the first move
+            double firstMoveCutoffRate() const;
+
+            // Adds the counters of other to these counters
+            Statistics& operator+=(const Statistics& other);
+        };
+
         // Sets a pointer to a boolean that becomes false when this thread is interrupted
         void setInterruptedPointer(const bool* p);
+        // Sets the maximum depth (in plies) of the search done by run()
+        // If the depth is larger than 0, run() uses iterative deepening and reports the score of each iteration through iterationDone()
+        // A depth of 0 (the default) means the position is solved completely
+        void setDepthLimit(const int& depth);
+        // Sets whether the moves are ordered by the threats they create together with the history heuristic (the default)
+        // or by the history heuristic only, used by the benchmark to compare both
+        void setThreatOrdering(const bool& enabled);
+        // Sets whether alphaBeta() only uses the exact values found in the transposition table, so the value it finds is never a bound
+        // (DrawWin or DrawLoss) as long as the search starts with the full window and there is no root bound
+        // The bounds in the table are still used to order the moves, this is slower and only meant for analysing positions
+        void setExactValues(const bool& enabled);
+        // Sets whether run() solves the board by the exact distance to the end of the game (win as fast as possible, lose as slow
+        // as possible) instead of only by Win, Draw or Loss, the depth of the value it reports is that distance then
+        // It uses alphaBetaDepth() without a horizon, whose integer scores give tighter bounds than the Win/Draw/Loss values
+        void setDistanceScores(const bool& enabled);
+        // Sets whether run() solves the board with a sequence of null-window searches (see nullWindowSearch()) instead of
+        // one search with the full window, the searches by depth or by distance don't use it
+        void setNullWindow(const bool& enabled);
+        // Makes this searcher a helper that searches the same position as other searchers (lazy SMP)
+        // Every helper index gives a different initial move ordering, so the helpers work on different parts of the tree
+        // and profit from each other's results through the shared transposition table
+        // Index 0 (the default) uses the normal move ordering
+        void setHelperIndex(const int& index);
+        // Sets the bound that's shared by the searchers of all moves at the root, it holds the value the player at the root
+        // is already sure of because of another move (see raiseRootBound())
+        // If red is at the root it's a lower bound (alpha), otherwise an upper bound (beta), alphaBeta() narrows its window with it at every node
+        // So the search only proves whether this move is better than the moves that have already been solved
+        void setRootBound(const QAtomicInt* bound, const bool& redAtRoot);
 
         // Called if this class is used as QRunnable
         // This call alphaBeta() with the board that's given in the constructor
-        // The result is outputted through the done() signal
+        // The result is outputted through the done() signal, together with the statistics of the search
         void run();
 
+        // Returns the statistics of all searches done by this searcher
+        const Statistics& statistics() const;
+
         // Finds the value of the given position
-        PositionValue alphaBeta(const quint64& bitBoard, const quint64& redBoard, const quint64& yellowBoard, PositionValue alpha, PositionValue beta);
+        PositionValue alphaBeta(const MaskBoard& board, PositionValue alpha, PositionValue beta);
+        // Finds the value of the given position like alphaBeta() with the full window, but by asking one question per search:
+        // first whether red does better than a Loss and then, if so, whether red wins
+        // The narrow windows cause more cutoffs, the second search profits from the positions the first one stored
+        PositionValue nullWindowSearch(const MaskBoard& board);
+        // Finds the score of the given position by searching at most depth plies deep, positions at the horizon are scored by evaluate()
+        // Fail-soft: a score <= alpha is an upper bound, a score >= beta is a lower bound
+        // If depth is at least the amount of empty squares the horizon is never reached, the score is exact then:
+        // 0 for a draw, WinScore minus the distance to the end of the game for a win and the negation of that for a loss
+        int alphaBetaDepth(const MaskBoard& board, const int& depth, int alpha, int beta);
 
         // Load the known position from the database
         static void loadPositionDatabase();
         // Whether or not the position database is loaded
         static bool positionDatabaseLoaded();
+        // Sets the packed position database file that loadPositionDatabase() maps in memory
+        // If it's not set, the file given by the environment variable INTELLICON_POSITION_DB or positions.pdb next to the executable is used
+        // If the file doesn't exist, the position database is read from the resources
+        static void setPositionDatabaseFile(const QString& fileName);
+        // Writes the position database to a packed file that can be mapped by loadPositionDatabase(), returns false on failure
+        static bool savePositionDatabase(const QString& fileName);
+        // Loads a book with the values of positions with the given amount of pieces (10 or 12), as generated by intellicon-bookgen
+        // The file is either a packed file or the prefix of the win, draw and loss files, returns false if it can't be read
+        // loadPositionDatabase() loads positions-10.pdb and positions-12.pdb next to the executable if they exist
+        // Warning: this may not be called while any AlphaBetaSearcher is running
+        static bool loadOpeningBook(const int& pieces, const QString& fileName);
+        // Whether the book of positions with the given amount of pieces is loaded
+        static bool openingBookLoaded(const int& pieces);
+        // Removes the book of positions with the given amount of pieces (10 or 12), its positions are searched again
+        // Warning: this may not be called while any AlphaBetaSearcher is running
+        static void unloadOpeningBook(const int& pieces);
+
+        // Sets the amount of megabytes used to cache the values of positions that took a lot of work to find
+        // Warning: this may not be called while any AlphaBetaSearcher is running
+        static void setTranspositionTableSize(const int& megabytes);
+        // Removes all positions from the transposition table
+        // Warning: this may not be called while any AlphaBetaSearcher is running
+        static void clearTranspositionTable();
+        // Opens the cache file that keeps the positions stored in the transposition table across processes (at most maxEntries of them)
+        // The positions already in the file are put in the transposition table, returns false if the file can't be used
+        // loadPositionDatabase() opens the file given by the environment variable INTELLICON_POSITION_CACHE if it's set
+        // Warning: this may not be called while any AlphaBetaSearcher is running
+        static bool openPositionCache(const QString& fileName, const int& maxEntries = 1 << 20);
+        // Appends the positions found since the last flush to the cache file (if it's opened), returns false on failure
+        static bool flushPositionCache();
+        // The amount of positions in the cache file, 0 if it isn't opened
+        static int positionCacheSize();
+
+        // Makes the shared root bound at least as good (for the player at the root) as the value of a move that's solved
+        // The bound should start at Loss if red is at the root and at Win otherwise
+        static void raiseRootBound(QAtomicInt& bound, const PositionValue& val, const bool& redAtRoot);
+        // Returns what the value reported by the searcher of a move at the root proves, given the shared root bound when it's reported
+        // If the bound was a Draw, a Draw only proves the move isn't better than the moves solved before it: it's at most a Draw
+        // (DrawLoss) if red is at the root and at least a Draw (DrawWin) otherwise, all other values are exact or already a bound
+        static PositionValue rootMoveValue(const QAtomicInt& bound, const PositionValue& val, const bool& redAtRoot);
+        // Returns the moves that are expected to be played from the given position, by following the best moves stored in the transposition table
+        // Only entries with an exact value (or exact score) are followed, the best move of a bound is only the move that caused a cutoff
+        // The line stops at a position that isn't in the table with an exact value and a best move (the position databases and the cache
+        // file don't store moves), complete tells whether the line reaches the end of the game instead
+        // Warning: this may not be called while any AlphaBetaSearcher is running
+        static std::vector<int> principalVariation(const BitBoard& board, bool& complete);
 
         // Creates a PositionValue
         static PositionValue createPositionValue(const PositionValue& val, const quint16& depth);
@@ -50,35 +175,108 @@ class AlphaBetaSearcher : public QObject, public QRunnable
         static quint16 getDepth(const PositionValue& val);
 
     signals:
-        void done(const int& move, const quint16& val);
+        void done(const int& move, const quint16& val, const AlphaBetaSearcher::Statistics& stats);
+        // Emitted after every completed iteration of a depth limited search
+        void iterationDone(const int& move, const int& depth, const int& score);
         
     private:
         BitBoard board;                 // The board to use when run() is called
         int move;                       // The move that was given in the constructor, this will be outputted with the result through the done() signal
         const bool* keepRunning;        // Whether we should keep searching for moves (true) or are interrupted (false)
+        Statistics stats;               // The statistics of the searches done by this searcher
+        int depthLimit;                 // The maximum depth of the search done by run(), 0 if there is no limit
+        bool horizonReached;            // Whether a position at the horizon was evaluated during the current iteration
+        bool threatOrdering;            // Whether the moves are ordered by the threats they create too
+        bool exactValues;               // Whether the bounds stored in the transposition table are ignored by alphaBeta()
+        bool distanceScores;            // Whether run() finds the exact distance to the end of the game
+        bool nullWindow;                // Whether run() uses a sequence of null-window searches
+        const QAtomicInt* rootBound;    // The bound shared by the searchers of all moves at the root, 0 if there is none
+        bool rootBoundIsAlpha;          // Whether the root bound is a lower bound (red is at the root) or an upper bound
 
-        // A simple class used to manage the position database lockers
-        class PositionDatabaseLockers
-        {
-            public:
-                PositionDatabaseLockers();
-                ~PositionDatabaseLockers();
-
-                QReadWriteLock* operator[](const unsigned int& n);
+        // The 8-ply positions of which the value is known
+        static PositionDatabase posDb;
+        // The packed file that should be mapped, empty if the default location should be used
+        static QString posDbFileName;
+        // The 10-ply and 12-ply positions of which the value is known (if they're loaded)
+        static PositionDatabase openingBooks[2];
+        // Locker used while loading the position database
+        static QReadWriteLock posDbLocker;
 
-            private:
-                QReadWriteLock* lockers[12];
-        };
-
-        // Positions of which the value is known
-        static QHash<quint64, PositionValue> posDb[];
-        // Lockers used to lock the position database
-        static PositionDatabaseLockers posDbLockers;
+        // Positions of which the value has been found during the search (shared by all searchers)
+        // The positions are stored by their canonical key (see MaskBoard::canonicalKey()), which is verified on every probe
+        static TranspositionTable transpositionTable;
+        // The file the positions stored in the transposition table are written to (if it's opened)
+        static PositionCache positionCache;
 
         // Used for the history heuristic optimization
         int historyHeuristic[2][42];
         // Initialise the history heuristic array
         void initHistoryHeuristic();
+
+        // The best moves found by earlier iterations of the depth limited search, these are tried first by the next iteration
+        // Every position is stored at the index given by its hash, a newer position simply replaces an older one
+        static const int MoveTableSize = 4096;
+        quint64 moveTablePositions[MoveTableSize];
+        qint8 moveTableMoves[MoveTableSize];
+        // Looks up the value of a position in the position database, the opening books or the transposition table
+        // tableKey is the canonical key of the board (see MaskBoard::canonicalKey()), returns true and sets data if the position is found
+        bool lookUp(const MaskBoard& board, const quint64& tableKey, quint64& data);
+
+        // Stores a position that took a lot of work in the transposition table and the cache file
+        // The best move (-1 if it isn't known) is only stored in the transposition table
+        static void storePosition(const MaskBoard& board, const quint64& tableKey, const PositionValue& value, const int& bestMove);
+
+        // The kinds of scores stored by the searches that reach the end of the game (see alphaBetaDepth())
+        enum ScoreBound
+        {
+            NoScore,        // Only the value is known
+            ExactScore,     // The score is the exact distance to the end of the game
+            LowerScore,     // The score is a lower bound
+            UpperScore      // The score is an upper bound
+        };
+        // Stores the score of a position searched until the end of the game (or a bound on it) in the transposition table,
+        // together with the value it implies, so alphaBeta() can use it too, only the value is written to the cache file
+        static void storeScore(const MaskBoard& board, const quint64& tableKey, const int& score, const ScoreBound& bound, const int& bestMove);
+
+        // Returns the key of the board in the position databases and the cache file: the smallest of the BoardInts of the board and its mirror image
+        // Converting the board to a BoardInt takes more work than the canonical key, so this is only done for the positions that need it
+        static quint64 databaseKey(const MaskBoard& board);
+
+        // Creates the data of a transposition table entry: the value (which tells whether it's exact, a lower bound (DrawWin)
+        // or an upper bound (DrawLoss)), the depth and the best move of the board, -1 if the best move isn't known
+        static quint64 createTableData(const MaskBoard& board, const quint64& tableKey, const PositionValue& value, const int& bestMove);
+        // Finds the lowest and highest score (see alphaBetaDepth()) a position can have according to the data found by lookUp()
+        // remaining is the amount of empty squares of the position, lower and upper are equal if the score is exact
+        static void tableScoreBounds(const quint64& data, const int& remaining, int& lower, int& upper);
+        // Returns the best move of the board stored in the data found by lookUp(), -1 if it isn't known
+        static int getTableMove(const MaskBoard& board, const quint64& tableKey, const quint64& data);
+
+        // Returns the index of the given position (MaskBoard::key()) in the move table
+        static int moveTableIndex(const quint64& key);
+        // Moves the given column to the front of the moves, returns the amount of moves that are put in front (0 or 1)
+        // Nothing happens if the column is -1 or isn't one of the moves
+        static unsigned int moveToFront(std::vector<int>& moves, const int& col);
+
+        // Solves the board given in the constructor using iterative deepening up to depthLimit plies
+        PositionValue iterativeDeepening();
+
+        // Finds the moves that have to be searched in the given position
+        // If the opponent threatens to win only the forced move is returned, moves that allow the opponent to win directly are left out
+        // Returns false if the opponent can't be stopped from winning
+        bool findMoves(const MaskBoard& board, std::vector<int>& moves);
+        // Scores every move by the threats the player to move has after that move, the scores are stored at the index of the column
+        // All scores are 0 if threat ordering is disabled
+        void scoreThreats(const MaskBoard& board, const std::vector<int>& moves, int* scores) const;
+        // Moves the move with the highest history score plus threat score (from index move on) to index move
+        void selectMove(const MaskBoard& board, std::vector<int>& moves, const unsigned int& move, const int* threatScores) const;
+        // Updates the history heuristic after the move at index move caused a cutoff
+        void rewardMove(const MaskBoard& board, const std::vector<int>& moves, const unsigned int& move, const bool& redToMove);
+
+        // Returns a heuristic score of the position, based on the threats (empty squares that complete a group) of both players
+        // Red profits most from threats on odd rows, yellow from threats on even rows
+        static int evaluate(const quint64& redBoard, const quint64& yellowBoard);
 };
 
+Q_DECLARE_METATYPE(AlphaBetaSearcher::Statistics)
+
 #endif // ALPHABETASEARCHER_H
@@ -0,0 +1,17 @@
+#-------------------------------------------------
+#
+# Benchmark for the alpha-beta search
+#
+#-------------------------------------------------
+
+QT       += core
+QT       -= gui
+
+TARGET = intellicon-bench
+TEMPLATE = app
+CONFIG   += console
+CONFIG   -= app_bundle
+
+include(../engine.pri)
+
+SOURCES += main.cpp
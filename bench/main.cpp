@@ -0,0 +1,967 @@
+/************************************************************************
+* This file is part of IntelliCon.                                      *
+*                                                                       *
+* IntelliCon is free software: you can redistribute it and/or modify    *
+* it under the terms of the GNU General Public License as published by  *
+* the Free Software Foundation, either version 3 of the License, or     *
+* (at your option) any later version.                                   *
+*                                                                       *
+* IntelliCon is distributed in the hope that it will be useful,         *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+* GNU General Public License for more details.                          *
+*                                                                       *
+* You should have received a copy of the GNU General Public License     *
+* along with IntelliCon.  If not, see <http://www.gnu.org/licenses/>.   *
+************************************************************************/
+
+#include <QCoreApplication>
+#include <QStringList>
+#include <QFile>
+#include <QDataStream>
+#include <QTextStream>
+#include <QElapsedTimer>
+#include <vector>
+#include <map>
+#include "alphabetasearcher.h"
+#include "solver.h"
+#include "maskboard.h"
+#include "bitops.h"
+#include "movesimulator.h"
+
+#ifdef Q_OS_UNIX
+#include <sys/resource.h>
+#endif
+
+// A small pseudo random generator (xorshift64*), so the same positions are chosen on every platform and with every Qt version
+class Random
+{
+    public:
+        Random(const quint64& seed)
+        : state(seed == 0 ? Q_UINT64_C(0x9E3779B97F4A7C15) : seed) {}
+
+        // Returns a number in the range [0, n)
+        int next(const int& n)
+        {
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+            return ((state * Q_UINT64_C(2685821657736338717)) >> 33) % n;
+        }
+
+    private:
+        quint64 state;
+};
+
+// The results of one group of positions
+struct GroupResult
+{
+    int pieces;                             // The amount of pieces on the board of each position
+    int positions;                          // The amount of positions that were solved
+    AlphaBetaSearcher::Statistics stats;    // The statistics of all searches together
+    qint64 wallTime;                        // The time it took to solve all positions (in ns)
+    long peakRss;                           // The peak resident set size of the whole process so far, measured after solving the group (in kB)
+                                            // Since it's the peak since the start of the process, a group can't report less than the groups before it
+};
+
+// Prints how this program should be used
+void printUsage(QTextStream& out)
+{
+    out<<"Usage: intellicon-bench [options]"<<endl
+       <<"Solves a fixed set of positions for each group and reports the performance of the alpha-beta search."<<endl
+       <<"The positions are sampled from the 8-ply position database, followed by random moves until the group's piece count is reached."<<endl
+       <<"Solving a position means finding the value of every playable column, just like the computer player does."<<endl
+       <<"The process peak RSS is the peak of the whole process up to the end of the group, not of the group itself."<<endl
+       <<endl
+       <<"Options:"<<endl
+       <<"  --groups <list>     Comma separated piece counts, at least 8 (default: 12,16,20,24)"<<endl
+       <<"  --positions <n>     The amount of positions per group (default: 20)"<<endl
+       <<"  --seed <n>          The seed used to choose the positions (default: 1)"<<endl
+       <<"  --tt-size <MB>      The size of the transposition table in megabytes (default: 64)"<<endl
+       <<"  --scaling <list>    Comma separated thread counts: solve every group with the parallel search using each thread count"<<endl
+       <<"                      and report the speedup compared to the first thread count"<<endl
+       <<"  --ordering          Solve every group with and without ordering the moves by the threats they create, and report the node counts"<<endl
+       <<"  --null-window       Solve every group with the full window and with null-window searches, and report the node counts"<<endl
+       <<"  --simulate          Simulate every playable column of every position with the strategic rules, and report the time and the results"<<endl
+       <<"  --dump <file>       With --simulate: write the result of every simulated move to the file"<<endl
+       <<"  --compare <file>    With --simulate: compare the result of every simulated move with a file written by --dump,"<<endl
+       <<"                      report every move that differs and exit with status 1 if any move differs"<<endl
+       <<"  --primitives        Measure the time per call of the board operations, with the portable and the hardware bit operations"<<endl
+       <<"  --portable          Use the portable bit operations, even if the cpu supports POPCNT, TZCNT and LZCNT"<<endl
+       <<"  --json              Print the results as JSON"<<endl
+       <<"  --help              Show this help"<<endl;
+}
+
+// Reads all positions from the 8-ply position database
+std::vector<quint64> readDatabasePositions()
+{
+    std::vector<quint64> out;
+    const QString filenames[] = {":/data/win-pos.db", ":/data/draw-pos.db", ":/data/loss-pos.db"};
+    for(int i = 0; i < 3; ++i)
+    {
+        QFile file(filenames[i]);
+        file.open(QIODevice::ReadOnly);
+        QDataStream stream(&file);
+
+        quint64 position = 0;
+        while(!stream.atEnd())
+        {
+            stream>>position;
+            out.push_back(position);
+        }
+    }
+    return out;
+}
+
+// Chooses a position with the given amount of pieces
+// A position is chosen from the database, then random moves are played until the amount of pieces is reached
+// No move is played that ends the game, and the player to move can't win directly in the chosen position
+quint64 samplePosition(const std::vector<quint64>& dbPositions, const int& pieces, Random& random)
+{
+    while(true)
+    {
+        BitBoard board(dbPositions[random.next(dbPositions.size())]);
+        bool failed = false;
+        while(!failed && board.pieceCount() < pieces)
+        {
+            // Find the moves that don't end the game
+            std::vector<int> moves;
+            for(int col = 0; col < 7; ++col)
+            {
+                if(!board.canMove(col)) continue;
+
+                const BitBoard newBoard(board.move(col));
+                if(!newBoard.redHasWon() && !newBoard.yellowHasWon() && !newBoard.isFull())
+                    moves.push_back(col);
+            }
+
+            if(moves.empty())
+                failed = true;
+            else
+                board.setBitBoard(board.move(moves[random.next(moves.size())]));
+        }
+
+        // Don't use positions where the player to move can win directly
+        for(int col = 0; !failed && col < 7; ++col)
+        {
+            if(!board.canMove(col)) continue;
+
+            const BitBoard newBoard(board.move(col));
+            if(newBoard.redHasWon() || newBoard.yellowHasWon())
+                failed = true;
+        }
+
+        if(!failed)
+            return board.toInt();
+    }
+}
+
+// Returns the peak resident set size of this process in kB (or 0 if it can't be determined)
+long peakRss()
+{
+#ifdef Q_OS_UNIX
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef Q_OS_MAC
+    return usage.ru_maxrss / 1024;  // Mac OS reports bytes instead of kilobytes
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return 0;
+#endif
+}
+
+// Solves all positions, one position after another in this thread so the node counts are reproducible
+// If threatOrdering is false, the moves are ordered by the history heuristic only
+// If nullWindow is true, the columns are solved by null-window searches (see AlphaBetaSearcher::nullWindowSearch())
+GroupResult runGroup(const int& pieces, const std::vector<quint64>& positions, const bool& threatOrdering = true, const bool& nullWindow = false)
+{
+    GroupResult result;
+    result.pieces = pieces;
+    result.positions = positions.size();
+
+    result.wallTime = 0;
+
+    const bool keepRunning = true;
+    QElapsedTimer timer;
+    for(std::vector<quint64>::const_iterator pos = positions.begin(); pos != positions.end(); ++pos)
+    {
+        // Every position starts with an empty transposition table, so the results don't depend on the previous positions
+        // Clearing the table isn't part of the measured time
+        AlphaBetaSearcher::clearTranspositionTable();
+        timer.start();
+
+        const BitBoard board(*pos);
+        AlphaBetaSearcher searcher(board, -1);
+        searcher.setInterruptedPointer(&keepRunning);
+        searcher.setThreatOrdering(threatOrdering);
+        for(int col = 0; col < 7; ++col)
+        {
+            if(!board.canMove(col)) continue;
+
+            const BitBoard newBoard(board.move(col));
+            if(nullWindow)
+                searcher.nullWindowSearch(MaskBoard(newBoard.toInt()));
+            else
+                searcher.alphaBeta(MaskBoard(newBoard.toInt()), AlphaBetaSearcher::Loss, AlphaBetaSearcher::Win);
+        }
+        result.stats += searcher.statistics();
+        result.wallTime += timer.nsecsElapsed();
+    }
+    result.peakRss = peakRss();
+
+    return result;
+}
+
+// The result of solving one group of positions with the parallel search
+struct ScalingResult
+{
+    int pieces;                             // The amount of pieces on the board of each position
+    int threads;                            // The amount of searchers that ran at the same time
+    AlphaBetaSearcher::Statistics stats;    // The statistics of the searchers that reported the results
+    qint64 wallTime;                        // The time it took to solve all positions (in ns)
+};
+
+// Solves all positions with the parallel search of Solver, like the command line solver does
+ScalingResult runScaling(const int& pieces, const int& threads, const std::vector<quint64>& positions)
+{
+    ScalingResult result;
+    result.pieces = pieces;
+    result.threads = threads;
+    result.wallTime = 0;
+
+    Solver solver;
+    solver.setThreadCount(threads);
+    QElapsedTimer timer;
+    for(std::vector<quint64>::const_iterator pos = positions.begin(); pos != positions.end(); ++pos)
+    {
+        AlphaBetaSearcher::clearTranspositionTable();
+        timer.start();
+        result.stats += solver.solve(BitBoard(*pos)).statistics;
+        result.wallTime += timer.nsecsElapsed();
+    }
+
+    return result;
+}
+
+void printScaling(QTextStream& out, const std::vector<ScalingResult>& results, const bool& json)
+{
+    if(json)
+        out<<"{"<<endl
+           <<"  \"scaling\": ["<<endl;
+    else
+        out<<"pieces  threads   time (ms)  speedup        nodes"<<endl;
+
+    // The speedup is relative to the first thread count of the same group
+    qint64 baseTime = 0;
+    for(unsigned int i = 0; i < results.size(); ++i)
+    {
+        const ScalingResult& result = results[i];
+        if(i == 0 || results[i - 1].pieces != result.pieces)
+            baseTime = result.wallTime;
+        const double speedup = result.wallTime == 0 ? 0.0 : static_cast<double>(baseTime) / result.wallTime;
+
+        if(json)
+            out<<"    {"
+               <<"\"pieces\": "<<result.pieces<<", "
+               <<"\"threads\": "<<result.threads<<", "
+               <<"\"wallTimeMs\": "<<QString::number(result.wallTime / 1e6, 'f', 3)<<", "
+               <<"\"speedup\": "<<QString::number(speedup, 'f', 3)<<", "
+               <<"\"nodes\": "<<result.stats.nodes
+               <<"}"<<(i + 1 == results.size() ? "" : ",")<<endl;
+        else
+            out<<QString::number(result.pieces).rightJustified(6)<<"  "
+               <<QString::number(result.threads).rightJustified(7)<<"  "
+               <<QString::number(result.wallTime / 1e6, 'f', 1).rightJustified(10)<<"  "
+               <<QString::number(speedup, 'f', 2).rightJustified(7)<<"  "
+               <<QString::number(result.stats.nodes).rightJustified(11)<<endl;
+    }
+
+    if(json)
+        out<<"  ]"<<endl
+           <<"}"<<endl;
+}
+
+// The result of simulating one move
+struct SimulatedMove
+{
+    quint64 position;                       // The position in which the move is played (BoardInt)
+    int col;                                // The column of the move
+    int result;                             // The MoveSmartness returned by the simulator
+};
+
+// The results of simulating the moves of one group of positions
+struct SimulationResult
+{
+    int pieces;                             // The amount of pieces on the board of each position
+    int simulations;                        // The amount of moves that were simulated
+    int results[AllSolvedWin + 1];          // How often each MoveSmartness was the result
+    qint64 wallTime;                        // The time it took to simulate all moves (in ns)
+    std::vector<SimulatedMove> moves;       // The result of every move, so it can be compared with another build (--dump and --compare)
+};
+
+// Simulates every playable column of every position for the player to move, like the computer player does before it searches
+SimulationResult runSimulations(const int& pieces, const std::vector<quint64>& positions)
+{
+    SimulationResult result;
+    result.pieces = pieces;
+    result.simulations = 0;
+    for(int i = 0; i <= AllSolvedWin; ++i)
+        result.results[i] = 0;
+    result.wallTime = 0;
+
+    const bool keepRunning = true;
+    QElapsedTimer timer;
+    for(std::vector<quint64>::const_iterator pos = positions.begin(); pos != positions.end(); ++pos)
+    {
+        // Every position starts with an empty result cache, so the time doesn't depend on the previous positions
+        MoveSimulator::clearResultCache();
+
+        const BitBoard board(*pos);
+        const bool isRed = board.redToMove();
+        for(int col = 0; col < 7; ++col)
+        {
+            if(!board.canMove(col)) continue;
+
+            timer.start();
+            MoveSimulator simulator(BitBoard(board.move(col)).toBoard(), col, isRed, isRed ? AllSolved : AllSolvedWin);
+            simulator.setInterruptedPointer(&keepRunning);
+            const MoveSmartness smartness = simulator.simulate();
+            result.wallTime += timer.nsecsElapsed();
+            ++result.results[smartness];
+            ++result.simulations;
+
+            const SimulatedMove move = {*pos, col, smartness};
+            result.moves.push_back(move);
+        }
+    }
+
+    return result;
+}
+
+void printSimulations(QTextStream& out, const std::vector<SimulationResult>& results, const bool& json)
+{
+    if(json)
+        out<<"{"<<endl
+           <<"  \"simulations\": ["<<endl;
+    else
+        out<<"pieces  simulations   time (ms)  time/move (us)  not solved  tree search  all solved  solved+win"<<endl;
+
+    for(unsigned int i = 0; i < results.size(); ++i)
+    {
+        const SimulationResult& result = results[i];
+        const double timePerMove = result.simulations == 0 ? 0.0 : result.wallTime / 1e3 / result.simulations;
+
+        if(json)
+            out<<"    {"
+               <<"\"pieces\": "<<result.pieces<<", "
+               <<"\"simulations\": "<<result.simulations<<", "
+               <<"\"wallTimeMs\": "<<QString::number(result.wallTime / 1e6, 'f', 3)<<", "
+               <<"\"timePerMoveUs\": "<<QString::number(timePerMove, 'f', 3)<<", "
+               <<"\"notAllSolved\": "<<result.results[NotAllSolved]<<", "
+               <<"\"needsTreeSearch\": "<<result.results[NeedsTreeSearch]<<", "
+               <<"\"allSolved\": "<<result.results[AllSolved]<<", "
+               <<"\"allSolvedWin\": "<<result.results[AllSolvedWin]
+               <<"}"<<(i + 1 == results.size() ? "" : ",")<<endl;
+        else
+            out<<QString::number(result.pieces).rightJustified(6)<<"  "
+               <<QString::number(result.simulations).rightJustified(11)<<"  "
+               <<QString::number(result.wallTime / 1e6, 'f', 1).rightJustified(10)<<"  "
+               <<QString::number(timePerMove, 'f', 1).rightJustified(14)<<"  "
+               <<QString::number(result.results[NotAllSolved]).rightJustified(10)<<"  "
+               <<QString::number(result.results[NeedsTreeSearch]).rightJustified(11)<<"  "
+               <<QString::number(result.results[AllSolved]).rightJustified(10)<<"  "
+               <<QString::number(result.results[AllSolvedWin]).rightJustified(10)<<endl;
+    }
+
+    if(json)
+        out<<"  ]"<<endl
+           <<"}"<<endl;
+}
+
+// Returns the name of a MoveSmartness, as used in the table of --simulate
+QString smartnessName(const int& smartness)
+{
+    const char* names[] = {"unknown", "impossible", "direct lose", "not solved", "tree search", "all solved", "solved+win"};
+    return smartness >= 0 && smartness <= AllSolvedWin ? names[smartness] : QString::number(smartness);
+}
+
+// Writes the result of every simulated move to the given file, one move per line: the position (BoardInt), the column and the MoveSmartness
+// Returns false if the file can't be opened
+bool dumpSimulations(const QString& fileName, const std::vector<SimulationResult>& results)
+{
+    QFile file(fileName);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+        return false;
+
+    QTextStream stream(&file);
+    for(std::vector<SimulationResult>::const_iterator result = results.begin(); result != results.end(); ++result)
+    {
+        for(std::vector<SimulatedMove>::const_iterator move = result->moves.begin(); move != result->moves.end(); ++move)
+            stream<<move->position<<' '<<move->col<<' '<<move->result<<endl;
+    }
+    return true;
+}
+
+// Compares the result of every simulated move with the results in a file written by dumpSimulations()
+// The counts per MoveSmartness can stay the same while single moves change, so every move is compared on its own
+// Every move with a different result, and every move that's only in one of both, is reported to out
+// Returns the amount of differences, or -1 if the file can't be read
+int compareSimulations(QTextStream& out, const QString& fileName, const std::vector<SimulationResult>& results)
+{
+    QFile file(fileName);
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return -1;
+
+    // Read the results of the reference, a move is identified by its position and column
+    // The second value of an entry tells whether the move was simulated this time as well
+    typedef std::map<std::pair<quint64, int>, std::pair<int, bool> > ReferenceMap;
+    ReferenceMap reference;
+    QTextStream stream(&file);
+    while(!stream.atEnd())
+    {
+        const QStringList fields = stream.readLine().trimmed().split(' ', QString::SkipEmptyParts);
+        if(fields.isEmpty()) continue;
+
+        bool ok = fields.size() == 3;
+        quint64 position = 0;
+        int col = 0, result = 0;
+        if(ok)  position = fields[0].toULongLong(&ok);
+        if(ok)  col = fields[1].toInt(&ok);
+        if(ok)  result = fields[2].toInt(&ok);
+        if(!ok) return -1;
+        reference[std::make_pair(position, col)] = std::make_pair(result, false);
+    }
+
+    int differences = 0;
+    for(std::vector<SimulationResult>::const_iterator result = results.begin(); result != results.end(); ++result)
+    {
+        for(std::vector<SimulatedMove>::const_iterator move = result->moves.begin(); move != result->moves.end(); ++move)
+        {
+            ReferenceMap::iterator entry = reference.find(std::make_pair(move->position, move->col));
+            if(entry == reference.end())
+            {
+                out<<"Position "<<move->position<<" ("<<result->pieces<<" pieces), column "<<move->col
+                   <<": "<<smartnessName(move->result)<<", not in the reference"<<endl;
+                ++differences;
+                continue;
+            }
+
+            entry->second.second = true;
+            if(entry->second.first != move->result)
+            {
+                out<<"Position "<<move->position<<" ("<<result->pieces<<" pieces), column "<<move->col
+                   <<": "<<smartnessName(move->result)<<", the reference has "<<smartnessName(entry->second.first)<<endl;
+                ++differences;
+            }
+        }
+    }
+
+    // The moves of the reference that weren't simulated, e.g. because other groups or another seed were used
+    for(ReferenceMap::const_iterator entry = reference.begin(); entry != reference.end(); ++entry)
+    {
+        if(entry->second.second) continue;
+
+        out<<"Position "<<entry->first.first<<", column "<<entry->first.second
+           <<": not simulated, the reference has "<<smartnessName(entry->second.first)<<endl;
+        ++differences;
+    }
+
+    return differences;
+}
+
+/// The board operations measured by --primitives
+//  Every operation is called with a position as BoardInt and as MaskBoard, the result is summed so the call can't be left out
+typedef quint64 (*Primitive)(const quint64& position, const MaskBoard& board);
+
+quint64 emptyPrimitive(const quint64& position, const MaskBoard&)
+{ return position; }
+quint64 bitcountPrimitive(const quint64& position, const MaskBoard&)
+{ return BitBoard::bitcount(position); }
+quint64 playableRowPrimitive(const quint64& position, const MaskBoard&)
+{
+    quint64 out = 0;
+    for(int col = 0; col < 7; ++col)
+        out += BitBoard::playableRow(position, col);
+    return out;
+}
+quint64 movePrimitive(const quint64& position, const MaskBoard& board)
+{
+    quint64 out = 0;
+    for(int col = 0; col < 7; ++col)
+        out += BitBoard::move(position, col, board.redToMove());
+    return out;
+}
+quint64 flipPrimitive(const quint64& position, const MaskBoard&)
+{ return BitBoard::flip(position); }
+quint64 isWinnerPrimitive(const quint64&, const MaskBoard& board)
+{ return BitBoard::isWinner(board.current()); }
+quint64 setBitBoardPrimitive(const quint64& position, const MaskBoard&)
+{ return BitBoard(position).redToInt(); }
+quint64 maskBoardPrimitive(const quint64& position, const MaskBoard&)
+{ return MaskBoard(position).current(); }
+quint64 maskToIntPrimitive(const quint64&, const MaskBoard& board)
+{ return board.toInt(); }
+quint64 maskPlayableRowPrimitive(const quint64&, const MaskBoard& board)
+{
+    quint64 out = 0;
+    for(int col = 0; col < 7; ++col)
+        out += board.playableRow(col);
+    return out;
+}
+quint64 maskPlayPrimitive(const quint64&, const MaskBoard& board)
+{
+    quint64 out = 0;
+    for(int col = 0; col < 7; ++col)
+        out += board.move(col).mask();
+    return out;
+}
+
+// The sum of all results of the operations
+volatile quint64 primitiveSum = 0;
+
+struct PrimitiveResult
+{
+    const char* name;           // The name of the operation
+    double nanoseconds[2];      // The time per call with the portable and the hardware bit operations (0 if not measured)
+};
+
+// Measures every operation with both implementations of the bit operations
+std::vector<PrimitiveResult> runPrimitives(const std::vector<quint64>& positions)
+{
+    const struct
+    {
+        const char* name;
+        Primitive primitive;
+        int calls;              // The amount of calls of the operation done by the primitive
+    } primitives[] = {
+        {"empty function call",     emptyPrimitive,             1},
+        {"BitBoard::bitcount",      bitcountPrimitive,          1},
+        {"BitBoard::playableRow",   playableRowPrimitive,       7},
+        {"BitBoard::move",          movePrimitive,              7},
+        {"BitBoard::flip",          flipPrimitive,              1},
+        {"BitBoard::isWinner",      isWinnerPrimitive,          1},
+        {"BitBoard::setBitBoard",   setBitBoardPrimitive,       1},
+        {"MaskBoard(BoardInt)",     maskBoardPrimitive,         1},
+        {"MaskBoard::toInt",        maskToIntPrimitive,         1},
+        {"MaskBoard::playableRow",  maskPlayableRowPrimitive,   7},
+        {"MaskBoard::move",         maskPlayPrimitive,          7}
+    };
+    const int primitiveCount = sizeof(primitives) / sizeof(primitives[0]);
+
+    std::vector<MaskBoard> boards;
+    for(std::vector<quint64>::const_iterator pos = positions.begin(); pos != positions.end(); ++pos)
+        boards.push_back(MaskBoard(*pos));
+
+    // Call every operation about 4 million times
+    const int passes = qMax(1, 4000000 / static_cast<int>(positions.size()));
+
+    std::vector<PrimitiveResult> results(primitiveCount);
+    const bool hardwareEnabled = BitOps::hardwareEnabled();
+    quint64 sum = 0;
+    for(int hardware = 0; hardware < 2; ++hardware)
+    {
+        BitOps::setHardwareEnabled(hardware == 1);
+        for(int i = 0; i < primitiveCount; ++i)
+        {
+            results[i].name = primitives[i].name;
+            results[i].nanoseconds[hardware] = 0.0;
+            if(hardware == 1 && !BitOps::hardwareSupported()) continue;
+
+            QElapsedTimer timer;
+            timer.start();
+            for(int pass = 0; pass < passes; ++pass)
+            {
+                for(unsigned int j = 0; j < positions.size(); ++j)
+                    sum += primitives[i].primitive(positions[j], boards[j]);
+            }
+            results[i].nanoseconds[hardware] = static_cast<double>(timer.nsecsElapsed()) / passes / positions.size() / primitives[i].calls;
+        }
+    }
+    BitOps::setHardwareEnabled(hardwareEnabled);
+
+    // Store the sum, otherwise the compiler may leave out the calls
+    primitiveSum = sum;
+
+    return results;
+}
+
+void printPrimitives(QTextStream& out, const std::vector<PrimitiveResult>& results, const bool& json)
+{
+    if(json)
+        out<<"{"<<endl
+           <<"  \"hardwareSupported\": "<<(BitOps::hardwareSupported() ? "true" : "false")<<","<<endl
+           <<"  \"primitives\": ["<<endl;
+    else
+        out<<"Bit operations supported by the cpu: "<<(BitOps::hardwareSupported() ? "POPCNT, TZCNT, LZCNT" : "none")<<endl
+           <<"operation                 portable (ns)  hardware (ns)"<<endl;
+
+    for(unsigned int i = 0; i < results.size(); ++i)
+    {
+        const PrimitiveResult& result = results[i];
+        if(json)
+            out<<"    {"
+               <<"\"operation\": \""<<result.name<<"\", "
+               <<"\"portableNs\": "<<QString::number(result.nanoseconds[0], 'f', 3)<<", "
+               <<"\"hardwareNs\": "<<(BitOps::hardwareSupported() ? QString::number(result.nanoseconds[1], 'f', 3) : QString("null"))
+               <<"}"<<(i + 1 == results.size() ? "" : ",")<<endl;
+        else
+            out<<QString(result.name).leftJustified(24)<<"  "
+               <<QString::number(result.nanoseconds[0], 'f', 2).rightJustified(13)<<"  "
+               <<(BitOps::hardwareSupported() ? QString::number(result.nanoseconds[1], 'f', 2) : QString("-")).rightJustified(13)<<endl;
+    }
+
+    if(json)
+        out<<"  ]"<<endl
+           <<"}"<<endl;
+}
+
+// Prints the node counts of the groups solved with the moves ordered by the history heuristic only and by the threats too
+void printOrdering(QTextStream& out, const std::vector<GroupResult>& historyResults, const std::vector<GroupResult>& threatResults, const bool& json)
+{
+    if(json)
+        out<<"{"<<endl
+           <<"  \"ordering\": ["<<endl;
+    else
+        out<<"pieces  positions  nodes (history)  nodes (threats)  reduction  time history (ms)  time threats (ms)"<<endl;
+
+    for(unsigned int i = 0; i < historyResults.size(); ++i)
+    {
+        const GroupResult& history = historyResults[i];
+        const GroupResult& threats = threatResults[i];
+        const double reduction = history.stats.nodes == 0 ? 0.0 : 1.0 - static_cast<double>(threats.stats.nodes) / history.stats.nodes;
+
+        if(json)
+            out<<"    {"
+               <<"\"pieces\": "<<history.pieces<<", "
+               <<"\"positions\": "<<history.positions<<", "
+               <<"\"historyNodes\": "<<history.stats.nodes<<", "
+               <<"\"threatNodes\": "<<threats.stats.nodes<<", "
+               <<"\"reduction\": "<<QString::number(reduction, 'f', 4)<<", "
+               <<"\"historyFirstMoveCutoffRate\": "<<QString::number(history.stats.firstMoveCutoffRate(), 'f', 2)<<", "
+               <<"\"threatFirstMoveCutoffRate\": "<<QString::number(threats.stats.firstMoveCutoffRate(), 'f', 2)<<", "
+               <<"\"historyWallTimeMs\": "<<QString::number(history.wallTime / 1e6, 'f', 3)<<", "
+               <<"\"threatWallTimeMs\": "<<QString::number(threats.wallTime / 1e6, 'f', 3)
+               <<"}"<<(i + 1 == historyResults.size() ? "" : ",")<<endl;
+        else
+            out<<QString::number(history.pieces).rightJustified(6)<<"  "
+               <<QString::number(history.positions).rightJustified(9)<<"  "
+               <<QString::number(history.stats.nodes).rightJustified(15)<<"  "
+               <<QString::number(threats.stats.nodes).rightJustified(15)<<"  "
+               <<QString::number(100.0 * reduction, 'f', 1).append('%').rightJustified(9)<<"  "
+               <<QString::number(history.wallTime / 1e6, 'f', 1).rightJustified(17)<<"  "
+               <<QString::number(threats.wallTime / 1e6, 'f', 1).rightJustified(17)<<endl;
+    }
+
+    if(json)
+        out<<"  ]"<<endl
+           <<"}"<<endl;
+}
+
+// Prints the node counts of the groups solved with the full window and with null-window searches
+void printNullWindow(QTextStream& out, const std::vector<GroupResult>& fullResults, const std::vector<GroupResult>& nullResults, const bool& json)
+{
+    if(json)
+        out<<"{"<<endl
+           <<"  \"nullWindow\": ["<<endl;
+    else
+        out<<"pieces  positions  nodes (full window)  nodes (null window)  reduction  time full (ms)  time null (ms)"<<endl;
+
+    for(unsigned int i = 0; i < fullResults.size(); ++i)
+    {
+        const GroupResult& full = fullResults[i];
+        const GroupResult& null = nullResults[i];
+        const double reduction = full.stats.nodes == 0 ? 0.0 : 1.0 - static_cast<double>(null.stats.nodes) / full.stats.nodes;
+
+        if(json)
+            out<<"    {"
+               <<"\"pieces\": "<<full.pieces<<", "
+               <<"\"positions\": "<<full.positions<<", "
+               <<"\"fullWindowNodes\": "<<full.stats.nodes<<", "
+               <<"\"nullWindowNodes\": "<<null.stats.nodes<<", "
+               <<"\"reduction\": "<<QString::number(reduction, 'f', 4)<<", "
+               <<"\"fullWindowWallTimeMs\": "<<QString::number(full.wallTime / 1e6, 'f', 3)<<", "
+               <<"\"nullWindowWallTimeMs\": "<<QString::number(null.wallTime / 1e6, 'f', 3)
+               <<"}"<<(i + 1 == fullResults.size() ? "" : ",")<<endl;
+        else
+            out<<QString::number(full.pieces).rightJustified(6)<<"  "
+               <<QString::number(full.positions).rightJustified(9)<<"  "
+               <<QString::number(full.stats.nodes).rightJustified(19)<<"  "
+               <<QString::number(null.stats.nodes).rightJustified(19)<<"  "
+               <<QString::number(100.0 * reduction, 'f', 1).append('%').rightJustified(9)<<"  "
+               <<QString::number(full.wallTime / 1e6, 'f', 1).rightJustified(13)<<"  "
+               <<QString::number(null.wallTime / 1e6, 'f', 1).rightJustified(14)<<endl;
+    }
+
+    if(json)
+        out<<"  ]"<<endl
+           <<"}"<<endl;
+}
+
+// Returns the amount of nodes per second
+double nodesPerSecond(const GroupResult& result)
+{ return result.wallTime == 0 ? 0.0 : 1e9 * result.stats.nodes / result.wallTime; }
+
+// Returns the fraction of transposition table probes that found the position
+double tableHitRate(const GroupResult& result)
+{ return result.stats.tableProbes == 0 ? 0.0 : static_cast<double>(result.stats.tableHits) / result.stats.tableProbes; }
+
+void printJson(QTextStream& out, const std::vector<GroupResult>& results, const int& positions, const quint64& seed)
+{
+    out<<"{"<<endl
+       <<"  \"positionsPerGroup\": "<<positions<<","<<endl
+       <<"  \"seed\": "<<seed<<","<<endl
+       <<"  \"groups\": ["<<endl;
+    for(unsigned int i = 0; i < results.size(); ++i)
+    {
+        const GroupResult& result = results[i];
+        out<<"    {"
+           <<"\"pieces\": "<<result.pieces<<", "
+           <<"\"positions\": "<<result.positions<<", "
+           <<"\"nodes\": "<<result.stats.nodes<<", "
+           <<"\"nodesPerSecond\": "<<QString::number(nodesPerSecond(result), 'f', 0)<<", "
+           <<"\"tableProbes\": "<<result.stats.tableProbes<<", "
+           <<"\"tableHits\": "<<result.stats.tableHits<<", "
+           <<"\"tableHitRate\": "<<QString::number(tableHitRate(result), 'f', 4)<<", "
+           <<"\"cutoffs\": "<<result.stats.cutoffs<<", "
+           <<"\"firstMoveCutoffs\": "<<result.stats.firstMoveCutoffs<<", "
+           <<"\"forcedMoves\": "<<result.stats.forcedMoves<<", "
+           <<"\"threatLosses\": "<<result.stats.threatLosses<<", "
+           <<"\"wallTimeMs\": "<<QString::number(result.wallTime / 1e6, 'f', 3)<<", "
+           <<"\"processPeakRssKb\": "<<result.peakRss
+           <<"}"<<(i + 1 == results.size() ? "" : ",")<<endl;
+    }
+    out<<"  ]"<<endl
+       <<"}"<<endl;
+}
+
+void printTable(QTextStream& out, const std::vector<GroupResult>& results)
+{
+    out<<"pieces  positions        nodes    nodes/s  TT hit rate  1st cutoff   time (ms)  process peak RSS (kB)"<<endl;
+    for(std::vector<GroupResult>::const_iterator pos = results.begin(); pos != results.end(); ++pos)
+    {
+        out<<QString::number(pos->pieces).rightJustified(6)<<"  "
+           <<QString::number(pos->positions).rightJustified(9)<<"  "
+           <<QString::number(pos->stats.nodes).rightJustified(11)<<"  "
+           <<QString::number(nodesPerSecond(*pos), 'f', 0).rightJustified(9)<<"  "
+           <<QString::number(100.0 * tableHitRate(*pos), 'f', 1).append('%').rightJustified(11)<<"  "
+           <<QString::number(pos->stats.firstMoveCutoffRate(), 'f', 1).append('%').rightJustified(10)<<"  "
+           <<QString::number(pos->wallTime / 1e6, 'f', 1).rightJustified(10)<<"  "
+           <<QString::number(pos->peakRss).rightJustified(21)<<endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    // Parse the arguments
+    std::vector<int> groups;
+    int positions = 20;
+    quint64 seed = 1;
+    bool json = false;
+    std::vector<int> scaling;
+    bool primitives = false;
+    bool ordering = false;
+    bool nullWindow = false;
+    bool simulate = false;
+    QString dumpFile;
+    QString compareFile;
+    const QStringList args = app.arguments();
+    for(int i = 1; i < args.size(); ++i)
+    {
+        bool ok = true;
+        if(args[i] == "--help" || args[i] == "-h")
+        {
+            printUsage(out);
+            return 0;
+        }
+        else if(args[i] == "--json")
+            json = true;
+        else if(args[i] == "--primitives")
+            primitives = true;
+        else if(args[i] == "--ordering")
+            ordering = true;
+        else if(args[i] == "--null-window")
+            nullWindow = true;
+        else if(args[i] == "--simulate")
+            simulate = true;
+        else if(args[i] == "--portable")
+            BitOps::setHardwareEnabled(false);
+        else if(args[i] == "--dump" && i + 1 < args.size())
+            dumpFile = args[++i];
+        else if(args[i] == "--compare" && i + 1 < args.size())
+            compareFile = args[++i];
+        else if(args[i] == "--groups" && i + 1 < args.size())
+        {
+            const QStringList list = args[++i].split(',');
+            for(QStringList::const_iterator pos = list.begin(); ok && pos != list.end(); ++pos)
+            {
+                groups.push_back(pos->toInt(&ok));
+                ok = ok && groups.back() >= 8 && groups.back() < 42;
+            }
+        }
+        else if(args[i] == "--scaling" && i + 1 < args.size())
+        {
+            const QStringList list = args[++i].split(',');
+            for(QStringList::const_iterator pos = list.begin(); ok && pos != list.end(); ++pos)
+            {
+                scaling.push_back(pos->toInt(&ok));
+                ok = ok && scaling.back() > 0;
+            }
+        }
+        else if(args[i] == "--positions" && i + 1 < args.size())
+            ok = (positions = args[++i].toInt(&ok)) > 0 && ok;
+        else if(args[i] == "--seed" && i + 1 < args.size())
+            seed = args[++i].toULongLong(&ok);
+        else if(args[i] == "--tt-size" && i + 1 < args.size())
+        {
+            const int megabytes = args[++i].toInt(&ok);
+            ok = ok && megabytes > 0;
+            if(ok)
+                AlphaBetaSearcher::setTranspositionTableSize(megabytes);
+        }
+        else
+            ok = false;
+
+        if(!ok)
+        {
+            printUsage(err);
+            return 1;
+        }
+    }
+    if(!simulate && (!dumpFile.isEmpty() || !compareFile.isEmpty()))
+    {
+        printUsage(err);
+        return 1;
+    }
+    if(groups.empty())
+    {
+        const int defaultGroups[] = {12, 16, 20, 24};
+        groups.assign(defaultGroups, defaultGroups + 4);
+    }
+
+    // Choose the positions, always in the same order so the same seed gives the same positions
+    AlphaBetaSearcher::loadPositionDatabase();
+    const std::vector<quint64> dbPositions = readDatabasePositions();
+    Random random(seed);
+    std::vector< std::vector<quint64> > groupPositions;
+    for(std::vector<int>::const_iterator pos = groups.begin(); pos != groups.end(); ++pos)
+    {
+        groupPositions.push_back(std::vector<quint64>());
+        for(int i = 0; i < positions; ++i)
+            groupPositions.back().push_back(samplePosition(dbPositions, *pos, random));
+    }
+
+    // Measure the board operations on all positions
+    if(primitives)
+    {
+        std::vector<quint64> allPositions;
+        for(std::vector< std::vector<quint64> >::const_iterator pos = groupPositions.begin(); pos != groupPositions.end(); ++pos)
+            allPositions.insert(allPositions.end(), pos->begin(), pos->end());
+        printPrimitives(out, runPrimitives(allPositions), json);
+        return 0;
+    }
+
+    // Compare the move ordering with and without the threats
+    if(ordering)
+    {
+        std::vector<GroupResult> historyResults;
+        std::vector<GroupResult> threatResults;
+        for(unsigned int i = 0; i < groups.size(); ++i)
+        {
+            if(!json)
+                err<<"Solving "<<positions<<" positions with "<<groups[i]<<" pieces, with and without threat ordering..."<<endl;
+            historyResults.push_back(runGroup(groups[i], groupPositions[i], false));
+            threatResults.push_back(runGroup(groups[i], groupPositions[i], true));
+        }
+        printOrdering(out, historyResults, threatResults, json);
+        return 0;
+    }
+
+    // Compare the full window with null-window searches
+    if(nullWindow)
+    {
+        std::vector<GroupResult> fullResults;
+        std::vector<GroupResult> nullResults;
+        for(unsigned int i = 0; i < groups.size(); ++i)
+        {
+            if(!json)
+                err<<"Solving "<<positions<<" positions with "<<groups[i]<<" pieces, with the full window and with null windows..."<<endl;
+            fullResults.push_back(runGroup(groups[i], groupPositions[i], true, false));
+            nullResults.push_back(runGroup(groups[i], groupPositions[i], true, true));
+        }
+        printNullWindow(out, fullResults, nullResults, json);
+        return 0;
+    }
+
+    // Measure the simulation of the moves with the strategic rules
+    if(simulate)
+    {
+        std::vector<SimulationResult> results;
+        for(unsigned int i = 0; i < groups.size(); ++i)
+        {
+            if(!json)
+                err<<"Simulating the moves of "<<positions<<" positions with "<<groups[i]<<" pieces..."<<endl;
+            results.push_back(runSimulations(groups[i], groupPositions[i]));
+        }
+        printSimulations(out, results, json);
+
+        if(!dumpFile.isEmpty() && !dumpSimulations(dumpFile, results))
+        {
+            err<<"Can't write "<<dumpFile<<endl;
+            return 1;
+        }
+
+        if(!compareFile.isEmpty())
+        {
+            const int differences = compareSimulations(err, compareFile, results);
+            if(differences == -1)
+            {
+                err<<"Can't read "<<compareFile<<endl;
+                return 1;
+            }
+
+            err<<differences<<" moves differ from "<<compareFile<<endl;
+            return differences == 0 ? 0 : 1;
+        }
+        return 0;
+    }
+
+    // Measure how the parallel search scales
+    if(!scaling.empty())
+    {
+        std::vector<ScalingResult> results;
+        for(unsigned int i = 0; i < groups.size(); ++i)
+        {
+            for(std::vector<int>::const_iterator threads = scaling.begin(); threads != scaling.end(); ++threads)
+            {
+                if(!json)
+                    err<<"Solving "<<positions<<" positions with "<<groups[i]<<" pieces using "<<*threads<<" threads..."<<endl;
+                results.push_back(runScaling(groups[i], *threads, groupPositions[i]));
+            }
+        }
+        printScaling(out, results, json);
+        return 0;
+    }
+
+    // Run the benchmark
+    std::vector<GroupResult> results;
+    for(unsigned int i = 0; i < groups.size(); ++i)
+    {
+        if(!json)
+            err<<"Solving "<<positions<<" positions with "<<groups[i]<<" pieces..."<<endl;
+        results.push_back(runGroup(groups[i], groupPositions[i]));
+    }
+
+    // Report the results
+    if(json)
+        printJson(out, results, positions, seed);
+    else
+        printTable(out, results);
+
+    return 0;
+}
@@ -16,6 +16,7 @@
 ************************************************************************/
 
 #include "bitboard.h"
+#include "bitops.h"
 
 // Public:
     BitBoard::BitBoard(const quint64& boardInt)
@@ -41,11 +42,7 @@
             quint64& opponent = colIsRed ? bitmapYellow : bitmapRed;
 
             // Determine in which row the highest piece currently is placed
-            highestPieces[col] = 5;
-            for(; highestPieces[col] >= 0; --highestPieces[col])
-            {
-                if(bitmap & (Q_UINT64_C(1) << (highestPieces[col] + 7 * col))) break;
-            }
+            highestPieces[col] = BitBoard::highestPiece(bitmap, col);
 
             // Copy the bits of the current column to the right ColorBoard
             color |= bitmap & (col1 << 7 * col);
@@ -131,6 +128,35 @@
                     (vert       & (vert      >> 2));
         }
 
+        quint64 BitBoard::threatSquares(const quint64& colorBoard, const quint64& occupied)
+        {
+            // 279258638311359 is in binary: 0111111 0111111 0111111 0111111 0111111 0111111 0111111
+            // In other words: all squares of the board (without the top-bits)
+            const quint64 squares = Q_UINT64_C(279258638311359);
+
+            // Vertical groups can only be completed on top
+            quint64 threats = (colorBoard << 1) & (colorBoard << 2) & (colorBoard << 3);
+
+            // The other groups can be completed on any of their four squares
+            // The shifts are the distance between two squares of the group: 7 for horizontal groups, 6 and 8 for the diagonal groups
+            // Since the top-bits are always false, a group can never wrap around to another column
+            const int shifts[] = {7, 6, 8};
+            for(int i = 0; i < 3; ++i)
+            {
+                const int shift = shifts[i];
+
+                quint64 pair = (colorBoard << shift) & (colorBoard << 2 * shift);
+                threats |= pair & (colorBoard << 3 * shift);
+                threats |= pair & (colorBoard >> shift);
+
+                pair = (colorBoard >> shift) & (colorBoard >> 2 * shift);
+                threats |= pair & (colorBoard << shift);
+                threats |= pair & (colorBoard >> 3 * shift);
+            }
+
+            return threats & squares & ~occupied;
+        }
+
         bool BitBoard::canMove(const quint64& bitmap, const int& col)
         {
             // If the bit at (5 + 7 * col) is set, then this column is full
@@ -139,17 +165,9 @@
 
         int BitBoard::playableRow(const quint64& bitmap, const int& col)
         {
-            // 63 is in binary: 0111111
-            // In other words: a completely filled column
-            const quint64 colBits = ((Q_UINT64_C(63) << 7 * col) & bitmap) >> 7 * col;
-
-            if(colBits & (1 << 5)) return -1;
-            if(colBits & (1 << 4)) return 5;
-            if(colBits & (1 << 3)) return 4;
-            if(colBits & (1 << 2)) return 3;
-            if(colBits & (1 << 1)) return 2;
-            if(colBits & (1 << 0)) return 1;
-            return 0;
+            // The playable square is the one above the highest piece
+            const int row = BitBoard::highestPiece(bitmap, col) + 1;
+            return row == 6 ? -1 : row;
         }
 
         quint64 BitBoard::move(const quint64& bitmap, const int& col, const bool& redToMove)
@@ -161,11 +179,7 @@
             const bool colIsRed = bitmap & (Q_UINT64_C(1) << (6 + 7 * col));
 
             // Determine in which row the highest piece currently is placed
-            int highestPiece = 5;
-            for(; highestPiece >= 0; --highestPiece)
-            {
-                if(bitmap & (Q_UINT64_C(1) << (highestPiece + 7 * col))) break;
-            }
+            const int highestPiece = BitBoard::highestPiece(bitmap, col);
 
             // This will be our result, just copy the current board to it
             quint64 result = bitmap;
@@ -213,25 +227,20 @@
 
         quint64 BitBoard::flip(const quint64& bitmap)
         {
-            // Start with an empty board
-            quint64 out = 0;
+            // Flipping the board reverses the order of the columns (groups of 7 bits, inclusive the top-bit)
+            // This is done with two swaps without looping over the columns, so it takes a constant (and small) amount of time
 
             // A set of bits where the bits 0...6 are true (i.e. one entire column of true bits, inclusive the top-bit)
             const quint64 col1 = (Q_UINT64_C(1) << 7) - 1;
+            // The first three columns
+            const quint64 cols3 = (Q_UINT64_C(1) << 21) - 1;
 
-            // Per column we copy the opposite column
-            for(int col = 0; col < 7; ++col)
-            {
-                if(col < 3)
-                    out |= (bitmap & (col1 << (7 * col))) << ((3 - col) * 2 * 7);
-                else if(col == 3)
-                    out |= bitmap & (col1 << (7 * col));
-                else
-                    out |= (bitmap & (col1 << (7 * col))) >> ((col - 3) * 2 * 7);
-            }
+            // Swap the three columns on the left with the three columns on the right, the middle column stays in place
+            const quint64 halves = ((bitmap >> 28) & cols3) | (bitmap & (col1 << 21)) | ((bitmap & cols3) << 28);
 
-            // Return the result
-            return out;
+            // Swap the outer columns of both halves, so column 0 and 2 and column 4 and 6
+            const quint64 outer = col1 | (col1 << 28);
+            return ((halves & outer) << 14) | ((halves >> 14) & outer) | (halves & ~(outer | (outer << 14)));
         }
         bool BitBoard::isFull(const quint64& bitmap)
         {
@@ -303,19 +312,17 @@
             return out;
         }
 
+        int BitBoard::bitcount(const quint64& x)
+        { return BitOps::popcount(x); }
+
 // Private:
-    int BitBoard::bitcount(quint64 x)
-    {
-        // Some constants needed in this function
-        const quint64 m1 = Q_UINT64_C(0x5555555555555555);  // Binary: 0101....
-        const quint64 m2 = Q_UINT64_C(0x3333333333333333);  // Binary: 00110011...
-        const quint64 m4 = Q_UINT64_C(0x0f0f0f0f0f0f0f0f);  // Binary: 0000111100001111...
-
-        x -= (x >> 1) & m1;             // Put count of each 2 bits into those 2 bits
-        x = (x & m2) + ((x >> 2) & m2); // Put count of each 4 bits into those 4 bits
-        x = (x + (x >> 4)) & m4;        // Put count of each 8 bits into those 8 bits
-        x += x >>  8;                   // Put count of each 16 bits into their lowest 8 bits
-        x += x >> 16;                   // Put count of each 32 bits into their lowest 8 bits
-        x += x >> 32;                   // Put count of each 64 bits into their lowest 8 bits
-        return x & 0x7f;
-    }
+    // Static:
+        int BitBoard::highestPiece(const quint64& bitmap, const int& col)
+        {
+            // 63 is in binary: 0111111
+            // In other words: a completely filled column
+            const quint64 colBits = (bitmap >> 7 * col) & 63;
+
+            // A bit below the bottom square makes sure there's always a set bit, it's found if the column is empty
+            return BitOps::highestBit((colBits << 1) | 1) - 1;
+        }
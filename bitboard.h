@@ -18,7 +18,7 @@
 #ifndef BITBOARD_H
 #define BITBOARD_H
 
-#include "gameboard.h"
+#include "board.h"
 #include <QtGlobal>
 #include <string>
 
@@ -111,6 +111,10 @@ class BitBoard
         // Returns false if any of the top-bits of colorBoard is true
         static bool isWinner(const quint64& colorBoard);
 
+        // Returns the empty squares that would give the colorBoard a winning group if they were filled (the threats of that color)
+        // The squares don't have to be playable, occupied contains the squares that are filled by either color
+        static quint64 threatSquares(const quint64& colorBoard, const quint64& occupied);
+
         // Returns whether a move can be made in the given column on the given board
         static bool canMove(const quint64& bitmap, const int& col);
         // Returns the row of the direct playable square in the given column
@@ -134,15 +138,18 @@ class BitBoard
         // Converts the given board (as a string) to an int
         static quint64 board2int(const std::string& board);
 
+        // Counts the number of set bits (see BitOps)
+        static int bitcount(const quint64& x);
+
     private:
+        // Returns the row of the highest piece in the given column, -1 if the column is empty
+        static int highestPiece(const quint64& bitmap, const int& col);
+
         quint64 bitmap;
         quint64 bitmapRed;
         quint64 bitmapYellow;
         bool red2move;
         int highestPieces[7];
-
-        // Counts the number of set bits
-        static int bitcount(quint64 x);
 };
 
 #endif // BITBOARD_H
@@ -0,0 +1,102 @@
+/************************************************************************
+* This file is part of IntelliCon.                                      *
+*                                                                       *
+* IntelliCon is free software: you can redistribute it and/or modify    *
+* it under the terms of the GNU General Public License as published by  *
+* the Free Software Foundation, either version 3 of the License, or     *
+* (at your option) any later version.                                   *
+*                                                                       *
+* IntelliCon is distributed in the hope that it will be useful,         *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+* GNU General Public License for more details.                          *
+*                                                                       *
+* You should have received a copy of the GNU General Public License     *
+* along with IntelliCon.  If not, see <http://www.gnu.org/licenses/>.   *
+************************************************************************/
+
+#include "bitops.h"
+
+#if defined(BITOPS_HARDWARE_GNU)
+    #include <cpuid.h>
+#endif
+
+/// Asking the cpu whether it supports the hardware implementation
+#if defined(BITOPS_HARDWARE_GNU)
+    static bool cpuSupportsHardware()
+    {
+        unsigned int eax, ebx, ecx, edx;
+
+        // POPCNT: leaf 1, bit 23 of ecx
+        if(!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & (1u << 23))) return false;
+        // TZCNT (part of BMI1): leaf 7, bit 3 of ebx
+        if(__get_cpuid_max(0, 0) < 7) return false;
+        __cpuid_count(7, 0, eax, ebx, ecx, edx);
+        if(!(ebx & (1u << 3))) return false;
+        // LZCNT: leaf 0x80000001, bit 5 of ecx
+        return __get_cpuid(0x80000001, &eax, &ebx, &ecx, &edx) && (ecx & (1u << 5));
+    }
+#elif defined(BITOPS_HARDWARE_MSVC)
+    static bool cpuSupportsHardware()
+    {
+        int info[4];
+
+        // POPCNT: leaf 1, bit 23 of ecx
+        __cpuid(info, 0);
+        const int maxLeaf = info[0];
+        __cpuid(info, 1);
+        if(!(info[2] & (1 << 23))) return false;
+        // TZCNT (part of BMI1): leaf 7, bit 3 of ebx
+        if(maxLeaf < 7) return false;
+        __cpuidex(info, 7, 0);
+        if(!(info[1] & (1 << 3))) return false;
+        // LZCNT: leaf 0x80000001, bit 5 of ecx
+        __cpuid(info, 0x80000000);
+        if(static_cast<unsigned int>(info[0]) < 0x80000001u) return false;
+        __cpuid(info, 0x80000001);
+        return info[2] & (1 << 5);
+    }
+#else
+    static bool cpuSupportsHardware()
+    { return false; }
+#endif
+
+// Public:
+    bool BitOps::hardwareSupported()
+    {
+        static const bool supported = cpuSupportsHardware();
+        return supported;
+    }
+
+    bool BitOps::hardwareEnabled()
+    { return hardware; }
+
+    void BitOps::setHardwareEnabled(const bool& enabled)
+    { hardware = enabled && hardwareSupported(); }
+
+    const char* BitOps::implementation()
+    { return hardwareEnabled() ? "hardware (POPCNT, TZCNT, LZCNT)" : "portable"; }
+
+// Private:
+    // The portable implementation is used until the hardware implementation is chosen
+    // This is initialised before any code runs, so the operations can even be used while other static objects are constructed
+    bool BitOps::hardware = false;
+
+    const quint64 BitOps::deBruijn;
+    const int BitOps::deBruijnIndex[64] = {
+         0, 47,  1, 56, 48, 27,  2, 60,
+        57, 49, 41, 37, 28, 16,  3, 61,
+        54, 58, 35, 52, 50, 42, 21, 44,
+        38, 32, 29, 23, 17, 11,  4, 62,
+        46, 55, 26, 59, 40, 36, 15, 53,
+        34, 51, 20, 43, 31, 22, 10, 45,
+        25, 39, 14, 33, 19, 30,  9, 24,
+        13, 18,  8, 12,  7,  6,  5, 63
+    };
+
+    // Chooses the implementation when the program starts
+    static struct HardwareSelector
+    {
+        HardwareSelector()
+        { BitOps::setHardwareEnabled(true); }
+    } hardwareSelector;
@@ -0,0 +1,161 @@
+/************************************************************************
+* This file is part of IntelliCon.                                      *
+*                                                                       *
+* IntelliCon is free software: you can redistribute it and/or modify    *
+* it under the terms of the GNU General Public License as published by  *
+* the Free Software Foundation, either version 3 of the License, or     *
+* (at your option) any later version.                                   *
+*                                                                       *
+* IntelliCon is distributed in the hope that it will be useful,         *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+* GNU General Public License for more details.                          *
+*                                                                       *
+* You should have received a copy of the GNU General Public License     *
+* along with IntelliCon.  If not, see <http://www.gnu.org/licenses/>.   *
+************************************************************************/
+#ifndef BITOPS_H
+#define BITOPS_H
+
+#include <QtGlobal>
+
+// The hardware implementation is only available on x86-64 cpus
+// GCC and Clang use inline assembly, so the instructions can be used without compiling the whole program for a specific cpu
+#if defined(Q_CC_GNU) && defined(__x86_64__)
+    #define BITOPS_HARDWARE_GNU
+#elif defined(Q_CC_MSVC) && defined(_M_X64)
+    #define BITOPS_HARDWARE_MSVC
+    #include <intrin.h>
+    #include <immintrin.h>
+#endif
+
+/** BitOps: the bit operations used by the boards
+  If the cpu supports them the POPCNT, TZCNT and LZCNT instructions are used, otherwise a portable implementation is used.
+  Which implementation is used is decided once when the program starts (by asking the cpu with CPUID),
+  so the program doesn't have to be compiled for a specific cpu.
+  Both implementations are inlined, every operation only tests the cached choice, which always goes the same way.
+**/
+class BitOps
+{
+    public:
+        // Counts the number of set bits
+        static int popcount(const quint64& x);
+        // Returns the index of the lowest set bit
+        // Warning: x may not be 0!
+        static int lowestBit(const quint64& x);
+        // Returns the index of the highest set bit
+        // Warning: x may not be 0!
+        static int highestBit(const quint64& x);
+
+        // Whether the cpu supports all instructions that are used by the hardware implementation
+        static bool hardwareSupported();
+        // Whether the hardware implementation is used
+        static bool hardwareEnabled();
+        // Switches between the hardware implementation (if it's supported) and the portable implementation
+        // Used by the benchmark to compare both, the hardware implementation is enabled by default
+        // Warning: this may not be called while another thread uses these operations
+        static void setHardwareEnabled(const bool& enabled);
+        // Returns a short description of the implementation that's used
+        static const char* implementation();
+
+    private:
+        // Whether the hardware implementation is used
+        static bool hardware;
+
+        // The portable implementation
+        static int portablePopcount(const quint64& x);
+        static int portableLowestBit(const quint64& x);
+        static int portableHighestBit(const quint64& x);
+
+        // A De Bruijn sequence: every 6 bits long part of it is different
+        // Multiplying it with a power of 2 moves a different part into the top 6 bits, the table converts that part back to the bit index
+        static const quint64 deBruijn = Q_UINT64_C(0x03f79d71b4cb0a89);
+        static const int deBruijnIndex[64];
+};
+
+// These are called at every node of the search, so they're inlined
+inline int BitOps::popcount(const quint64& x)
+{
+#if defined(BITOPS_HARDWARE_GNU)
+    if(hardware)
+    {
+        quint64 count;
+        __asm__("popcntq %1, %0" : "=r"(count) : "rm"(x) : "cc");
+        return static_cast<int>(count);
+    }
+#elif defined(BITOPS_HARDWARE_MSVC)
+    if(hardware)
+        return static_cast<int>(__popcnt64(x));
+#endif
+    return portablePopcount(x);
+}
+
+inline int BitOps::lowestBit(const quint64& x)
+{
+#if defined(BITOPS_HARDWARE_GNU)
+    if(hardware)
+    {
+        quint64 index;
+        __asm__("tzcntq %1, %0" : "=r"(index) : "rm"(x) : "cc");
+        return static_cast<int>(index);
+    }
+#elif defined(BITOPS_HARDWARE_MSVC)
+    if(hardware)
+        return static_cast<int>(_tzcnt_u64(x));
+#endif
+    return portableLowestBit(x);
+}
+
+inline int BitOps::highestBit(const quint64& x)
+{
+#if defined(BITOPS_HARDWARE_GNU)
+    if(hardware)
+    {
+        quint64 zeros;
+        __asm__("lzcntq %1, %0" : "=r"(zeros) : "rm"(x) : "cc");
+        return 63 - static_cast<int>(zeros);
+    }
+#elif defined(BITOPS_HARDWARE_MSVC)
+    if(hardware)
+        return 63 - static_cast<int>(_lzcnt_u64(x));
+#endif
+    return portableHighestBit(x);
+}
+
+inline int BitOps::portablePopcount(const quint64& bits)
+{
+    // Some constants needed in this function
+    const quint64 m1 = Q_UINT64_C(0x5555555555555555);  // Binary: 0101....
+    const quint64 m2 = Q_UINT64_C(0x3333333333333333);  // Binary: 00110011...
+    const quint64 m4 = Q_UINT64_C(0x0f0f0f0f0f0f0f0f);  // Binary: 0000111100001111...
+
+    quint64 x = bits;
+    x -= (x >> 1) & m1;             // Put count of each 2 bits into those 2 bits
+    x = (x & m2) + ((x >> 2) & m2); // Put count of each 4 bits into those 4 bits
+    x = (x + (x >> 4)) & m4;        // Put count of each 8 bits into those 8 bits
+    x += x >>  8;                   // Put count of each 16 bits into their lowest 8 bits
+    x += x >> 16;                   // Put count of each 32 bits into their lowest 8 bits
+    x += x >> 32;                   // Put count of each 64 bits into their lowest 8 bits
+    return x & 0x7f;
+}
+
+inline int BitOps::portableLowestBit(const quint64& x)
+{
+    // Set all bits up to the lowest set bit, these bits are handled the same as the highest set bit
+    return deBruijnIndex[((x ^ (x - 1)) * deBruijn) >> 58];
+}
+
+inline int BitOps::portableHighestBit(const quint64& x)
+{
+    // Set all bits below the highest set bit
+    quint64 y = x;
+    y |= y >> 1;
+    y |= y >> 2;
+    y |= y >> 4;
+    y |= y >> 8;
+    y |= y >> 16;
+    y |= y >> 32;
+    return deBruijnIndex[(y * deBruijn) >> 58];
+}
+
+#endif // BITOPS_H
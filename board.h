@@ -0,0 +1,32 @@
+/************************************************************************
+* This file is part of IntelliCon.                                      *
+*                                                                       *
+* IntelliCon is free software: you can redistribute it and/or modify    *
+* it under the terms of the GNU General Public License as published by  *
+* the Free Software Foundation, either version 3 of the License, or     *
+* (at your option) any later version.                                   *
+*                                                                       *
+* IntelliCon is distributed in the hope that it will be useful,         *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+* GNU General Public License for more details.                          *
+*                                                                       *
+* You should have received a copy of the GNU General Public License     *
+* along with IntelliCon.  If not, see <http://www.gnu.org/licenses/>.   *
+************************************************************************/
+
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <vector>
+
+enum Piece
+{
+    Empty   = 0,
+    Red     = 1,
+    Yellow  = 2
+};
+
+typedef std::vector< std::vector<Piece> > Board;
+
+#endif // BOARD_H
@@ -16,25 +16,74 @@
 ************************************************************************/
 
 #include "boardext.h"
+#include "bitboard.h"
 #include <cstdlib>
 #include <cmath>
 
+// A group is a set of 4 squares in a line, on the board there are 69 of them
+// Every group is stored with the square its threat starts at and the direction it goes in (see LineThreat)
+struct Group
+{
+    quint64 squares;            // The squares of the group as a ColorBoard
+    int col;                    // The column of the square the threat starts at
+    int row;                    // The row of the square the threat starts at
+    LineThreat::Direction dir;  // The direction of the threat
+    int cols[4];                // The columns of the squares, in the order of LineThreat::at()
+    int rows[4];                // The rows of the squares, in the order of LineThreat::at()
+};
+
+// The groups are ordered by the column and row they start at and then by their direction, this is the order in which
+// the threats are listed, so the solutions are found (and tried) in the same order as when the board was searched square by square
+static Group groups[69];
+
+// Fills the groups when the program starts, so they're ready before any simulator (which may run in any thread) uses them
+static struct GroupFiller
+{
+    GroupFiller()
+    {
+        const LineThreat::Direction directions[4] = { LineThreat::Vertical, LineThreat::Horizontal, LineThreat::DiagonalRight, LineThreat::DiagonalLeft };
+        int count = 0;
+        for(int col = 0; col < 7; ++col)
+        {
+            for(int row = 0; row < 6; ++row)
+            {
+                for(int i = 0; i < 4; ++i)
+                {
+                    const LineThreat::Direction dir = directions[i];
+                    const int deltaCol = dir == LineThreat::Vertical ? 0 : (dir == LineThreat::DiagonalLeft ? -1 : 1);
+                    const int deltaRow = dir == LineThreat::Horizontal ? 0 : -1;
+
+                    // If there isn't room for 4 pieces, there is no group
+                    if((col + 3 * deltaCol) < 0 || (col + 3 * deltaCol) >= 7  || (row + 3 * deltaRow) < 0) continue;
+
+                    Group& group = groups[count++];
+                    group.squares = 0;
+                    group.col = col;
+                    group.row = row;
+                    group.dir = dir;
+                    for(int j = 0; j < 4; ++j)
+                    {
+                        group.cols[j] = col + j * deltaCol;
+                        group.rows[j] = row + j * deltaRow;
+                        group.squares |= Q_UINT64_C(1) << (group.rows[j] + 7 * group.cols[j]);
+                    }
+                }
+            }
+        }
+    }
+} groupFiller;
+
 // Public:
     BoardExt::BoardExt(const bool& playerIsRed)
-    : isRed(playerIsRed), oddThreatCol1(-1), oddThreatCol2(-1) { }
+    : isRed(playerIsRed), level3Threats(0), level3WinningThreats(0), cantCombineWords(0), oddThreatCol1(-1), oddThreatCol2(-1) { }
 
     BoardExt::~BoardExt()
     {
-        for(std::list<LineThreat*>::iterator pos = threats.begin(); pos != threats.end(); ++pos)
-            delete *pos;
-        for(std::list<LineThreat*>::iterator pos = winningThreats.begin(); pos != winningThreats.end(); ++pos)
-            delete *pos;
-        for(std::list<ThreatSolution*>::iterator pos = solutions.begin(); pos != solutions.end(); ++pos)
-            delete *pos;
+        // The threats and solutions are destroyed by their pools
     }
 
     BoardExt::BoardExt(const Board& other, const bool& playerIsRed)
-    : Board(other), isRed(playerIsRed), oddThreatCol1(-1), oddThreatCol2(-1)
+    : Board(other), isRed(playerIsRed), level3Threats(0), level3WinningThreats(0), cantCombineWords(0), oddThreatCol1(-1), oddThreatCol2(-1)
     { }
 
     void BoardExt::changesMade(const Board& b)
@@ -71,81 +120,33 @@
 
     void BoardExt::searchForThreats()
     {
-        for(std::list<LineThreat*>::iterator pos = threats.begin(); pos != threats.end(); ++pos)
-            delete *pos;
-        threats.clear();
-        threatBoard.clear();
-        threatBoard.resize(7, ThreatBoardCol(6, std::list<LineThreat*>()));
-
-        const Piece ownColor = isRed ? Red : Yellow;
-        for(unsigned int col = 0; col < 7; ++col)
-        {
-            for(unsigned int row = 0; row < 6; ++row)
-            {
-                if(at(col)[row] != ownColor)
-                {
-                    findThreatsFromPoint(col, row, LineThreat::Vertical);
-                    findThreatsFromPoint(col, row, LineThreat::Horizontal);
-                    findThreatsFromPoint(col, row, LineThreat::DiagonalRight);
-                    findThreatsFromPoint(col, row, LineThreat::DiagonalLeft);
-                }
-            }
-        }
+        // The enemy has a threat in every group without our pieces
+        const BitBoard bitBoard(BitBoard::board2int(*this));
+        if(isRed)   addThreats(bitBoard.yellowToInt(), bitBoard.redToInt(), threatPool, threats, threatBoard, level3Threats);
+        else        addThreats(bitBoard.redToInt(), bitBoard.yellowToInt(), threatPool, threats, threatBoard, level3Threats);
     }
-    const std::list<LineThreat*>& BoardExt::threatsAt(const int& col, const int& row) const
+    const std::vector<LineThreat*>& BoardExt::threatsAt(const int& col, const int& row) const
     { return threatBoard[col][row]; }
-    const std::list<LineThreat*>& BoardExt::threatsAt(const PieceCoords& coords) const
+    const std::vector<LineThreat*>& BoardExt::threatsAt(const PieceCoords& coords) const
     { return threatBoard[coords.col][coords.row]; }
 
     bool BoardExt::hasLevel3Threat(const int& col, const int& row) const
-    {
-        const std::list<LineThreat*>& threatsAtThisSquare = threatBoard[col][row];
-        for(std::list<LineThreat*>::const_iterator pos = threatsAtThisSquare.begin(); pos != threatsAtThisSquare.end(); ++pos)
-        {
-            if((*pos)->level() == 3)
-                return true;
-        }
-        return false;
-    }
+    { return level3Threats & (Q_UINT64_C(1) << (row + 7 * col)); }
 
     void BoardExt::searchForWinningThreats()
     {
-        for(std::list<LineThreat*>::iterator pos = winningThreats.begin(); pos != winningThreats.end(); ++pos)
-            delete *pos;
-        winningThreats.clear();
-        winningThreatBoard.clear();
-        winningThreatBoard.resize(7, ThreatBoardCol(6, std::list<LineThreat*>()));
-
-        const Piece enemyColor = isRed ? Yellow : Red;
-        for(unsigned int col = 0; col < 7; ++col)
-        {
-            for(unsigned int row = 0; row < 6; ++row)
-            {
-                if(at(col)[row] != enemyColor)
-                {
-                    findWinningThreatsFromPoint(col, row, LineThreat::Vertical);
-                    findWinningThreatsFromPoint(col, row, LineThreat::Horizontal);
-                    findWinningThreatsFromPoint(col, row, LineThreat::DiagonalRight);
-                    findWinningThreatsFromPoint(col, row, LineThreat::DiagonalLeft);
-                }
-            }
-        }
+        // We have a threat in every group without pieces of the enemy
+        const BitBoard bitBoard(BitBoard::board2int(*this));
+        if(isRed)   addThreats(bitBoard.redToInt(), bitBoard.yellowToInt(), winningThreatPool, winningThreats, winningThreatBoard, level3WinningThreats);
+        else        addThreats(bitBoard.yellowToInt(), bitBoard.redToInt(), winningThreatPool, winningThreats, winningThreatBoard, level3WinningThreats);
     }
-    const std::list<LineThreat*>& BoardExt::winningThreatsAt(const int& col, const int& row) const
+    const std::vector<LineThreat*>& BoardExt::winningThreatsAt(const int& col, const int& row) const
     { return winningThreatBoard[col][row]; }
-    const std::list<LineThreat*>& BoardExt::winningThreatsAt(const PieceCoords& coords) const
+    const std::vector<LineThreat*>& BoardExt::winningThreatsAt(const PieceCoords& coords) const
     { return winningThreatBoard[coords.col][coords.row]; }
 
     bool BoardExt::hasLevel3WinningThreat(const int& col, const int& row) const
-    {
-        const std::list<LineThreat*>& winningAtThisSquare = winningThreatBoard[col][row];
-        for(std::list<LineThreat*>::const_iterator pos = winningAtThisSquare.begin(); pos != winningAtThisSquare.end(); ++pos)
-        {
-            if((*pos)->level() == 3)
-                return true;
-        }
-        return false;
-    }
+    { return level3WinningThreats & (Q_UINT64_C(1) << (row + 7 * col)); }
 
     bool BoardExt::hasOddThreat()
     {
@@ -157,7 +158,7 @@
         if(isRed)
         {
             PieceCoords coords;
-            for(std::list<LineThreat*>::const_iterator pos = winningThreats.begin(); pos != winningThreats.end(); ++pos)
+            for(std::vector<LineThreat*>::const_iterator pos = winningThreats.begin(); pos != winningThreats.end(); ++pos)
             {
                 if((*pos)->level() == 3)
                 {
@@ -199,8 +200,8 @@
 
                     if(playableCols[empty1.col] != empty1.row)
                     {
-                        std::list<LineThreat*> winningAtThisSquare = winningThreatBoard[empty1.col][empty1.row];
-                        for(std::list<LineThreat*>::const_iterator pos2 = winningAtThisSquare.begin(); pos2 != winningAtThisSquare.end(); ++pos2)
+                        const std::vector<LineThreat*>& winningAtThisSquare = winningThreatBoard[empty1.col][empty1.row];
+                        for(std::vector<LineThreat*>::const_iterator pos2 = winningAtThisSquare.begin(); pos2 != winningAtThisSquare.end(); ++pos2)
                         {
                             if((*pos2)->level() != 2) continue;
 
@@ -223,8 +224,8 @@
                     }
                     if(playableCols[empty2.col] != empty2.row)
                     {
-                        std::list<LineThreat*> winningAtThisSquare = winningThreatBoard[empty2.col][empty2.row];
-                        for(std::list<LineThreat*>::const_iterator pos2 = winningAtThisSquare.begin(); pos2 != winningAtThisSquare.end(); ++pos2)
+                        const std::vector<LineThreat*>& winningAtThisSquare = winningThreatBoard[empty2.col][empty2.row];
+                        for(std::vector<LineThreat*>::const_iterator pos2 = winningAtThisSquare.begin(); pos2 != winningAtThisSquare.end(); ++pos2)
                         {
                             if((*pos2)->level() != 2) continue;
 
@@ -253,15 +254,15 @@
 
     void BoardExt::solveByOddThreats()
     {
-        std::list<LineThreat*> possibleSolves;
+        std::vector<LineThreat*> possibleSolves;
         if(oddThreatCol1 != -1)
         {
             for(int row = playableCols[oddThreatCol1] + 1 - playableCols[oddThreatCol1] % 2; row < 6; ++row)
             {
                 if(row % 2 == 0)
                 {
-                    const std::list<LineThreat*>& solved = threatBoard[oddThreatCol1][row];
-                    for(std::list<LineThreat*>::const_iterator pos = solved.begin(); pos != solved.end(); ++pos)
+                    const std::vector<LineThreat*>& solved = threatBoard[oddThreatCol1][row];
+                    for(std::vector<LineThreat*>::const_iterator pos = solved.begin(); pos != solved.end(); ++pos)
                         (*pos)->solved = true;
                 }
                 else if(row > oddThreatRow1)
@@ -271,12 +272,12 @@
 
         if(oddThreatCol2 == -1)
         {
-            for(std::list<LineThreat*>::const_iterator pos = possibleSolves.begin(); pos != possibleSolves.end(); ++pos)
+            for(std::vector<LineThreat*>::const_iterator pos = possibleSolves.begin(); pos != possibleSolves.end(); ++pos)
                 (*pos)->solved = true;
         }
         else
         {
-            for(std::list<LineThreat*>::const_iterator pos = possibleSolves.begin(); pos != possibleSolves.end(); ++pos)
+            for(std::vector<LineThreat*>::const_iterator pos = possibleSolves.begin(); pos != possibleSolves.end(); ++pos)
             {
                 for(int row = oddThreatRow2 + 1; row < 6; ++row)
                 {
@@ -292,8 +293,8 @@
             if(oddThreatRow2 == oddThreatRow1)
             {
                 // Yellow will not get both the square above the crossing square and the odd square in the other column
-                const std::list<LineThreat*>& posSolves = threatBoard[oddThreatCol1][oddThreatRow1 + 1];
-                for(std::list<LineThreat*>::const_iterator pos = posSolves.begin(); pos != posSolves.end(); ++pos)
+                const std::vector<LineThreat*>& posSolves = threatBoard[oddThreatCol1][oddThreatRow1 + 1];
+                for(std::vector<LineThreat*>::const_iterator pos = posSolves.begin(); pos != posSolves.end(); ++pos)
                 {
                     if((*pos)->coversCoords(oddThreatCol2, oddThreatRow2 - 1))
                         (*pos)->solved = true;
@@ -305,8 +306,8 @@
                 {
                     for(int row = oddThreatRow1 + 2; row < 6; ++row)
                     {
-                        const std::list<LineThreat*>& solved = threatBoard[oddThreatCol1][row];
-                        for(std::list<LineThreat*>::const_iterator pos = solved.begin(); pos != solved.end(); ++pos)
+                        const std::vector<LineThreat*>& solved = threatBoard[oddThreatCol1][row];
+                        for(std::vector<LineThreat*>::const_iterator pos = solved.begin(); pos != solved.end(); ++pos)
                             (*pos)->solved = true;
                     }
                 }
@@ -317,8 +318,8 @@
             // the two squares to red
             if(playableCols[oddThreatCol2] < oddThreatRow2 && playableCols[oddThreatCol1] % 2 == 0)
             {
-                const std::list<LineThreat*>& posSolves = threatBoard[oddThreatCol1][playableCols[oddThreatCol1]];
-                for(std::list<LineThreat*>::const_iterator pos = posSolves.begin(); pos != posSolves.end(); ++pos)
+                const std::vector<LineThreat*>& posSolves = threatBoard[oddThreatCol1][playableCols[oddThreatCol1]];
+                for(std::vector<LineThreat*>::const_iterator pos = posSolves.begin(); pos != posSolves.end(); ++pos)
                 {
                     if((*pos)->coversCoords(oddThreatCol2, playableCols[oddThreatCol2]))
                         (*pos)->solved = true;
@@ -349,11 +350,13 @@
     void BoardExt::searchSolutions()
     {
         // Clear all solutions
-        for(std::list<LineThreat*>::iterator pos = threats.begin(); pos != threats.end(); ++pos)
+        for(std::vector<LineThreat*>::iterator pos = threats.begin(); pos != threats.end(); ++pos)
             (*pos)->solutions.clear();
-        for(std::list<ThreatSolution*>::iterator pos = solutions.begin(); pos != solutions.end(); ++pos)
-            delete *pos;
         solutions.clear();
+        solutionPool.clear();
+        beforePool.clear();
+        cantCombineBits.clear();
+        cantCombineWords = 0;
 
         // Find all possible solutions on the board
         findClaimEvens();
@@ -368,11 +371,19 @@
         findAfterBaseInverses();    // It's best to call these 2 functions last, for if they find something it will solve all threats
         findAfterVerticals();       // If they're called last their solutions will be pushed in front of all other solutions and will therefore be tried first
 
+        // Number the threats and solutions, so they can be used in bitsets
+        for(unsigned int i = 0; i < threats.size(); ++i)
+            threats[i]->index = i;
+        for(unsigned int i = 0; i < solutions.size(); ++i)
+            solutions[i]->index = i;
+        cantCombineWords = (solutions.size() + 63) / 64;
+        cantCombineBits.assign(solutions.size() * cantCombineWords, 0);
+
         // Connect all solutions that can't be combined
         bool cantBeCombined = false;
-        for(std::list<ThreatSolution*>::const_iterator pos = solutions.begin(); pos != solutions.end(); ++pos)
+        for(std::vector<ThreatSolution*>::const_iterator pos = solutions.begin(); pos != solutions.end(); ++pos)
         {
-            std::list<ThreatSolution*>::const_iterator pos2 = pos;
+            std::vector<ThreatSolution*>::const_iterator pos2 = pos;
             ++pos2;
             for(; pos2 != solutions.end(); ++pos2)
             {
@@ -393,13 +404,24 @@
                 // If the solutions can't be combined, we connect them
                 if(cantBeCombined)
                 {
-                    (*pos)->cantCombine.push_back(*pos2);
-                    (*pos2)->cantCombine.push_back(*pos);
+                    const unsigned int i = (*pos)->index;
+                    const unsigned int j = (*pos2)->index;
+                    cantCombineBits[i * cantCombineWords + j / 64] |= Q_UINT64_C(1) << (j % 64);
+                    cantCombineBits[j * cantCombineWords + i / 64] |= Q_UINT64_C(1) << (i % 64);
                 }
             }
         }
     }
 
+    bool BoardExt::cantCombine(const ThreatSolution* s1, const ThreatSolution* s2) const
+    { return cantCombineBits[s1->index * cantCombineWords + s2->index / 64] & (Q_UINT64_C(1) << (s2->index % 64)); }
+
+    const quint64* BoardExt::cantCombineWith(const ThreatSolution* solution) const
+    { return &cantCombineBits[solution->index * cantCombineWords]; }
+
+    unsigned int BoardExt::solutionWords() const
+    { return cantCombineWords; }
+
 // Private:
     // Static:
         const char BoardExt::SC1 = 1;
@@ -421,69 +443,35 @@
         /* AV */    {SC1,   SC1,    SC1,    SC1,    SC1,    SC1,    SC1,    SC1,    SC1,    SC1,    SC1 }
         };
 
-    bool BoardExt::findThreatsFromPoint(const int& col, const int& row, const LineThreat::Direction& dir)
+    void BoardExt::addThreats(const quint64& owner, const quint64& blocker, ObjectPool<LineThreat>& pool, std::vector<LineThreat*>& out, ThreatBoard& squareThreats, quint64& level3Squares)
     {
-        const int deltaCol = dir == LineThreat::Vertical ? 0 : (dir == LineThreat::DiagonalLeft ? -1 : 1);
-        const int deltaRow = dir == LineThreat::Horizontal ? 0 : -1;
-
-        // If there isn't room for 4 pieces, there won't be a threat either
-        if((col + 3 * deltaCol) < 0 || (col + 3 * deltaCol) >= 7  || (row + 3 * deltaRow) < 0) return false;
-
-        // Check if a line of 4 pieces is possible and count how many pieces are already in place
-        const Piece ownColor = isRed ? Red : Yellow;
-        const Piece enemyColor = isRed ? Yellow : Red;
-        int piecesInPlace = 0;
-        for(int i = 0; i < 4; ++i)
+        // Remove the threats of the previous search, the lists keep their memory
+        out.clear();
+        for(int col = 0; col < 7; ++col)
         {
-            const Piece currPiece = at(col + i * deltaCol)[row + i * deltaRow];
-
-            // If a piece of our own color is found, the enemy can never get a line of 4 pieces
-            // So no threat is found
-            if(currPiece == ownColor)
-                return false;
-
-            // If an enemy piece is found we increase the amount of enemy pieces that's in place
-            if(currPiece == enemyColor) ++piecesInPlace;
+            for(int row = 0; row < 6; ++row)
+                squareThreats[col][row].clear();
         }
+        pool.clear();
 
-        // Add the threat to the list
-        LineThreat* pointer = new LineThreat(col, row, dir, piecesInPlace);
-        threats.push_back(pointer);
-        for(int i = 0; i < 4; ++i)
-            threatBoard[col + i * deltaCol][row + i * deltaRow].push_back(pointer);
-        return true;
-    }
-    bool BoardExt::findWinningThreatsFromPoint(const int& col, const int& row, const LineThreat::Direction& dir)
-    {
-        const int deltaCol = dir == LineThreat::Vertical ? 0 : (dir == LineThreat::DiagonalLeft ? -1 : 1);
-        const int deltaRow = dir == LineThreat::Horizontal ? 0 : -1;
-
-        // If there isn't room for 4 pieces, there won't be a threat either
-        if((col + 3 * deltaCol) < 0 || (col + 3 * deltaCol) >= 7  || (row + 3 * deltaRow) < 0) return false;
-
-        // Check if a line of 4 pieces is possible and count how many pieces are already in place
-        const Piece ownColor = isRed ? Red : Yellow;
-        const Piece enemyColor = isRed ? Yellow : Red;
-        int piecesInPlace = 0;
-        for(int i = 0; i < 4; ++i)
+        level3Squares = 0;
+        for(int i = 0; i < 69; ++i)
         {
-            const Piece currPiece = at(col + i * deltaCol)[row + i * deltaRow];
-
-            // If a piece of the enemy color is found, we can never get a line of 4 pieces
-            // So no threat is found
-            if(currPiece == enemyColor)
-                return false;
-
-            // If one of our own pieces is found we increase the amount of enemy pieces that's in place
-            if(currPiece == ownColor) ++piecesInPlace;
+            // A group containing a piece of the blocker can never be completed by the owner
+            const Group& group = groups[i];
+            if(group.squares & blocker) continue;
+
+            // The level of the threat is the amount of pieces of the owner that are already in place
+            const int piecesInPlace = BitBoard::bitcount(group.squares & owner);
+            if(piecesInPlace >= 3)
+                level3Squares |= group.squares;
+
+            // Add the threat to the list
+            LineThreat* pointer = new(pool.allocate()) LineThreat(group.col, group.row, group.dir, piecesInPlace);
+            out.push_back(pointer);
+            for(int j = 0; j < 4; ++j)
+                squareThreats[group.cols[j]][group.rows[j]].push_back(pointer);
         }
-
-        // Add the threat to the list
-        LineThreat* pointer = new LineThreat(col, row, dir, piecesInPlace);
-        winningThreats.push_back(pointer);
-        for(int i = 0; i < 4; ++i)
-            winningThreatBoard[col + i * deltaCol][row + i * deltaRow].push_back(pointer);
-        return true;
     }
 
     void BoardExt::findClaimEvens()
@@ -497,12 +485,12 @@
             {
                 if(at(col)[row] != Empty || at(col)[row - 1] != Empty) break;
 
-                ThreatSolution* solution = new ThreatSolution(ThreatSolution::ClaimEven);
+                ThreatSolution* solution = new(solutionPool.allocate()) ThreatSolution(ThreatSolution::ClaimEven);
                 solution->addSquare(col, row);
                 solution->addSquare(col, row - 1);
 
-                const std::list<LineThreat*>& solvedThreats = threatBoard[col][row];
-                for(std::list<LineThreat*>::const_iterator pos = solvedThreats.begin(); pos != solvedThreats.end(); ++pos)
+                const std::vector<LineThreat*>& solvedThreats = threatBoard[col][row];
+                for(std::vector<LineThreat*>::const_iterator pos = solvedThreats.begin(); pos != solvedThreats.end(); ++pos)
                 {
                     solution->solvedThreats.push_back(*pos);
                     (*pos)->solutions.push_back(solution);
@@ -510,7 +498,7 @@
 
                 // A solution that solves nothing is of no use
                 if(solution->solvedThreats.size() == 0)
-                    delete solution;
+                    solutionPool.removeLast(solution);
                 else
                     solutions.push_back(solution);
             }
@@ -537,12 +525,12 @@
                 // Check if the two direct playable squares are part of the same group
                 if(playableCols[col] == playableCols[col2] || col2 - col == std::abs(playableCols[col] - playableCols[col2]))
                 {
-                    ThreatSolution* solution = new ThreatSolution(ThreatSolution::BaseInverse);
+                    ThreatSolution* solution = new(solutionPool.allocate()) ThreatSolution(ThreatSolution::BaseInverse);
                     solution->addSquare(col, playableCols[col]);
                     solution->addSquare(col2, playableCols[col2]);
 
-                    const std::list<LineThreat*>& solvedThreats = threatBoard[col][playableCols[col]];
-                    for(std::list<LineThreat*>::const_iterator pos = solvedThreats.begin(); pos != solvedThreats.end(); ++pos)
+                    const std::vector<LineThreat*>& solvedThreats = threatBoard[col][playableCols[col]];
+                    for(std::vector<LineThreat*>::const_iterator pos = solvedThreats.begin(); pos != solvedThreats.end(); ++pos)
                     {
                         if((*pos)->coversCoords(col2, playableCols[col2]))
                         {
@@ -553,7 +541,7 @@
 
                     // A solution that solves nothing is of no use
                     if(solution->solvedThreats.size() == 0)
-                        delete solution;
+                        solutionPool.removeLast(solution);
                     else
                         solutions.push_back(solution);
                 }
@@ -571,7 +559,7 @@
             {
                 if(at(col)[row] != Empty || at(col)[row - 1] != Empty) break;
 
-                ThreatSolution* solution = new ThreatSolution(ThreatSolution::Vertical);
+                ThreatSolution* solution = new(solutionPool.allocate()) ThreatSolution(ThreatSolution::Vertical);
                 solution->addSquare(col, row);
                 solution->addSquare(col, row - 1);
 
@@ -582,23 +570,23 @@
                     solution->makeGameWinner();
                     for(int row2 = row + 1; row2 < 6; ++row2)
                     {
-                        const std::list<LineThreat*>& additionalSolves = threatBoard[col][row2];
-                        for(std::list<LineThreat*>::const_iterator pos = additionalSolves.begin(); pos != additionalSolves.end(); ++pos)
+                        const std::vector<LineThreat*>& additionalSolves = threatBoard[col][row2];
+                        for(std::vector<LineThreat*>::const_iterator pos = additionalSolves.begin(); pos != additionalSolves.end(); ++pos)
                         {
                             solution->solvedThreats.push_back(*pos);
-                            (*pos)->solutions.push_front(solution);
+                            (*pos)->solutions.insert((*pos)->solutions.begin(), solution);
                         }
                     }
                 }
 
-                const std::list<LineThreat*>& solvedThreats = threatBoard[col][row - 1];
-                for(std::list<LineThreat*>::const_iterator pos = solvedThreats.begin(); pos != solvedThreats.end(); ++pos)
+                const std::vector<LineThreat*>& solvedThreats = threatBoard[col][row - 1];
+                for(std::vector<LineThreat*>::const_iterator pos = solvedThreats.begin(); pos != solvedThreats.end(); ++pos)
                 {
                     if((*pos)->dir == LineThreat::Vertical && (*pos)->startCoords().row != row - 1)
                     {
                         solution->solvedThreats.push_back(*pos);
                         if(solution->winsGame())
-                            (*pos)->solutions.push_front(solution);
+                            (*pos)->solutions.insert((*pos)->solutions.begin(), solution);
                         else
                             (*pos)->solutions.push_back(solution);
                     }
@@ -606,9 +594,9 @@
 
                 // A solution that solves nothing is of no use
                 if(solution->solvedThreats.size() == 0)
-                    delete solution;
+                    solutionPool.removeLast(solution);
                 else if(solution->winsGame())
-                    solutions.push_front(solution);
+                    solutions.insert(solutions.begin(), solution);
                 else
                     solutions.push_back(solution);
             }
@@ -618,7 +606,7 @@
     {
         PieceCoords coords;
         bool success;
-        for(std::list<LineThreat*>::const_iterator pos = winningThreats.begin(); pos != winningThreats.end(); ++pos)
+        for(std::vector<LineThreat*>::const_iterator pos = winningThreats.begin(); pos != winningThreats.end(); ++pos)
         {
             // Find out whether this solution can be used
             success = true;
@@ -647,9 +635,9 @@
             // If it can be used we add it to the list
             if(success)
             {
-                ThreatSolution* solution = new ThreatSolution(ThreatSolution::AfterEven);
-                std::list<LineThreat*> solvedThreats;
-                std::list<LineThreat*> possibleSolves;
+                ThreatSolution* solution = new(solutionPool.allocate()) ThreatSolution(ThreatSolution::AfterEven);
+                std::vector<LineThreat*> solvedThreats;
+                std::vector<LineThreat*> possibleSolves;
                 for(int i = 0; i < 4; ++i)
                 {
                     coords = (*pos)->at(i);
@@ -661,7 +649,7 @@
                             // If this is the first AfterEven column, we add all threats in that column above the AfterEven group
                             for(int row = coords.row + 1; row < 6; ++row)
                             {
-                                const std::list<LineThreat*>& solves = threatBoard[coords.col][row];
+                                const std::vector<LineThreat*>& solves = threatBoard[coords.col][row];
                                 possibleSolves.insert(possibleSolves.end(), solves.begin(), solves.end());
                             }
                         }
@@ -670,7 +658,7 @@
                             // If this isn't the first AfterEven column, we check if the threats that we already added also lie in this column
                             // If they do, we keep them in the list. If they don't, we remove them from the list
                             bool coversCoords;
-                            for(std::list<LineThreat*>::iterator pos2 = possibleSolves.begin(); pos2 != possibleSolves.end();)
+                            for(std::vector<LineThreat*>::iterator pos2 = possibleSolves.begin(); pos2 != possibleSolves.end();)
                             {
                                 coversCoords = false;
                                 for(int row = coords.row + 1; row < 6; ++row)
@@ -689,7 +677,7 @@
                         }
 
                         // Add the threats that are solved by the ClaimEvens used in this solution
-                        const std::list<LineThreat*>& solvedByClaimEven = threatBoard[coords.col][coords.row];
+                        const std::vector<LineThreat*>& solvedByClaimEven = threatBoard[coords.col][coords.row];
                         solvedThreats.insert(solvedThreats.end(), solvedByClaimEven.begin(), solvedByClaimEven.end());
 
                         // Add the used squares to this solution
@@ -699,23 +687,23 @@
                 }
 
                 // Add the threats that are solved by the ClaimEvens
-                for(std::list<LineThreat*>::const_iterator pos2 = solvedThreats.begin(); pos2 != solvedThreats.end(); ++pos2)
+                for(std::vector<LineThreat*>::const_iterator pos2 = solvedThreats.begin(); pos2 != solvedThreats.end(); ++pos2)
                 {
                     solution->solvedThreats.push_back(*pos2);
-                    (*pos2)->solutions.push_front(solution);
+                    (*pos2)->solutions.insert((*pos2)->solutions.begin(), solution);
                 }
                 // Add the threats that are solved by the AfterEven
-                for(std::list<LineThreat*>::const_iterator pos2 = possibleSolves.begin(); pos2 != possibleSolves.end(); ++pos2)
+                for(std::vector<LineThreat*>::const_iterator pos2 = possibleSolves.begin(); pos2 != possibleSolves.end(); ++pos2)
                 {
                     solution->solvedThreats.push_back(*pos2);
-                    (*pos2)->solutions.push_front(solution);
+                    (*pos2)->solutions.insert((*pos2)->solutions.begin(), solution);
                 }
 
                 // A solution that solves nothing is of no use
                 if(solution->solvedThreats.size() == 0)
-                    delete solution;
+                    solutionPool.removeLast(solution);
                 else
-                    solutions.push_front(solution);
+                    solutions.insert(solutions.begin(), solution);
             }
         }
     }
@@ -748,7 +736,7 @@
                 {
                     for(int row2 = fromRow2; row2 < 5; row2 += 2)
                     {
-                        ThreatSolution* solution = new ThreatSolution(ThreatSolution::LowInverse);
+                        ThreatSolution* solution = new(solutionPool.allocate()) ThreatSolution(ThreatSolution::LowInverse);
                         solution->addSquare(col, row);
                         solution->addSquare(col, row + 1);
                         solution->addSquare(col2, row2);
@@ -759,17 +747,17 @@
                         if(hasLevel3WinningThreat(col, row + 1) && hasLevel3WinningThreat(col2, row2 + 1))
                         {
                             solution->makeGameWinner();
-                            std::list<LineThreat*> additionalSolves;
+                            std::vector<LineThreat*> additionalSolves;
                             for(int r = row + 2; r < 6; ++r)
                                 additionalSolves.insert(additionalSolves.end(), threatBoard[col][r].begin(), threatBoard[col][r].end());
-                            for(std::list<LineThreat*>::iterator pos = additionalSolves.begin(); pos != additionalSolves.end(); ++pos)
+                            for(std::vector<LineThreat*>::iterator pos = additionalSolves.begin(); pos != additionalSolves.end(); ++pos)
                             {
                                 for(int r = row2 + 2; r < 6; ++r)
                                 {
                                     if((*pos)->coversCoords(col2, r))
                                     {
                                         solution->solvedThreats.push_back(*pos);
-                                        (*pos)->solutions.push_front(solution);
+                                        (*pos)->solutions.insert((*pos)->solutions.begin(), solution);
                                         break;
                                     }
                                 }
@@ -777,40 +765,40 @@
                         }
 
                         // Add the threats that are solved by the Verticals
-                        const std::list<LineThreat*>& solvedVerticals1 = threatBoard[col][row];
-                        for(std::list<LineThreat*>::const_iterator pos = solvedVerticals1.begin(); pos != solvedVerticals1.end(); ++pos)
+                        const std::vector<LineThreat*>& solvedVerticals1 = threatBoard[col][row];
+                        for(std::vector<LineThreat*>::const_iterator pos = solvedVerticals1.begin(); pos != solvedVerticals1.end(); ++pos)
                         {
                             if((*pos)->dir == LineThreat::Vertical && (*pos)->startCoords().row != row)
                             {
                                 solution->solvedThreats.push_back(*pos);
                                 if(solution->winsGame())
-                                    (*pos)->solutions.push_front(solution);
+                                    (*pos)->solutions.insert((*pos)->solutions.begin(), solution);
                                 else
                                     (*pos)->solutions.push_back(solution);
                             }
                         }
-                        const std::list<LineThreat*>& solvedVerticals2 = threatBoard[col2][row2];
-                        for(std::list<LineThreat*>::const_iterator pos = solvedVerticals2.begin(); pos != solvedVerticals2.end(); ++pos)
+                        const std::vector<LineThreat*>& solvedVerticals2 = threatBoard[col2][row2];
+                        for(std::vector<LineThreat*>::const_iterator pos = solvedVerticals2.begin(); pos != solvedVerticals2.end(); ++pos)
                         {
                             if((*pos)->dir == LineThreat::Vertical && (*pos)->startCoords().row != row2)
                             {
                                 solution->solvedThreats.push_back(*pos);
                                 if(solution->winsGame())
-                                    (*pos)->solutions.push_front(solution);
+                                    (*pos)->solutions.insert((*pos)->solutions.begin(), solution);
                                 else
                                     (*pos)->solutions.push_back(solution);
                             }
                         }
 
                         // Add the threats that are solved by the LowInverse part
-                        const std::list<LineThreat*>& solvedThreats = threatBoard[col][row + 1];
-                        for(std::list<LineThreat*>::const_iterator pos = solvedThreats.begin(); pos != solvedThreats.end(); ++pos)
+                        const std::vector<LineThreat*>& solvedThreats = threatBoard[col][row + 1];
+                        for(std::vector<LineThreat*>::const_iterator pos = solvedThreats.begin(); pos != solvedThreats.end(); ++pos)
                         {
                             if((*pos)->coversCoords(col2, row2 + 1))
                             {
                                 solution->solvedThreats.push_back(*pos);
                                 if(solution->winsGame())
-                                    (*pos)->solutions.push_front(solution);
+                                    (*pos)->solutions.insert((*pos)->solutions.begin(), solution);
                                 else
                                     (*pos)->solutions.push_back(solution);
                             }
@@ -818,9 +806,9 @@
 
                         // A solution that solves nothing is of no use
                         if(solution->solvedThreats.size() == 0)
-                            delete solution;
+                            solutionPool.removeLast(solution);
                         else if(solution->winsGame())
-                            solutions.push_front(solution);
+                            solutions.insert(solutions.begin(), solution);
                         else
                             solutions.push_back(solution);
                     }
@@ -857,7 +845,7 @@
                 {
                     for(int row2 = fromRow2; row2 < 5; row2 += 2)
                     {
-                        ThreatSolution* solution = new ThreatSolution(ThreatSolution::HighInverse);
+                        ThreatSolution* solution = new(solutionPool.allocate()) ThreatSolution(ThreatSolution::HighInverse);
                         solution->addSquare(col, row);
                         solution->addSquare(col, row + 1);
                         solution->addSquare(col, row + 2);
@@ -870,17 +858,17 @@
                         if(hasLevel3WinningThreat(col, row + 1) && hasLevel3WinningThreat(col2, row2 + 1))
                         {
                             solution->makeGameWinner();
-                            std::list<LineThreat*> additionalSolves;
+                            std::vector<LineThreat*> additionalSolves;
                             for(int r = row + 2; r < 6; ++r)
                                 additionalSolves.insert(additionalSolves.end(), threatBoard[col][r].begin(), threatBoard[col][r].end());
-                            for(std::list<LineThreat*>::iterator pos = additionalSolves.begin(); pos != additionalSolves.end(); ++pos)
+                            for(std::vector<LineThreat*>::iterator pos = additionalSolves.begin(); pos != additionalSolves.end(); ++pos)
                             {
                                 for(int r = row2 + 2; r < 6; ++r)
                                 {
                                     if((*pos)->coversCoords(col2, r))
                                     {
                                         solution->solvedThreats.push_back(*pos);
-                                        (*pos)->solutions.push_front(solution);
+                                        (*pos)->solutions.insert((*pos)->solutions.begin(), solution);
                                         break;
                                     }
                                 }
@@ -889,17 +877,17 @@
                         else if(playableCols[col] == row && hasLevel3WinningThreat(col, row) && hasLevel3WinningThreat(col2, row2 + 2))
                         {
                             solution->makeGameWinner();
-                            std::list<LineThreat*> additionalSolves;
+                            std::vector<LineThreat*> additionalSolves;
                             for(int r = row + 1; r < 6; ++r)
                                 additionalSolves.insert(additionalSolves.end(), threatBoard[col][r].begin(), threatBoard[col][r].end());
-                            for(std::list<LineThreat*>::iterator pos = additionalSolves.begin(); pos != additionalSolves.end(); ++pos)
+                            for(std::vector<LineThreat*>::iterator pos = additionalSolves.begin(); pos != additionalSolves.end(); ++pos)
                             {
                                 for(int r = row2 + 3; r < 6; ++r)
                                 {
                                     if((*pos)->coversCoords(col2, r))
                                     {
                                         solution->solvedThreats.push_back(*pos);
-                                        (*pos)->solutions.push_front(solution);
+                                        (*pos)->solutions.insert((*pos)->solutions.begin(), solution);
                                         break;
                                     }
                                 }
@@ -908,17 +896,17 @@
                         else if(playableCols[col2] == row2 && hasLevel3WinningThreat(col, row + 2) && hasLevel3WinningThreat(col2, row2))
                         {
                             solution->makeGameWinner();
-                            std::list<LineThreat*> additionalSolves;
+                            std::vector<LineThreat*> additionalSolves;
                             for(int r = row + 3; r < 6; ++r)
                                 additionalSolves.insert(additionalSolves.end(), threatBoard[col][r].begin(), threatBoard[col][r].end());
-                            for(std::list<LineThreat*>::iterator pos = additionalSolves.begin(); pos != additionalSolves.end(); ++pos)
+                            for(std::vector<LineThreat*>::iterator pos = additionalSolves.begin(); pos != additionalSolves.end(); ++pos)
                             {
                                 for(int r = row2 + 1; r < 6; ++r)
                                 {
                                     if((*pos)->coversCoords(col2, r))
                                     {
                                         solution->solvedThreats.push_back(*pos);
-                                        (*pos)->solutions.push_front(solution);
+                                        (*pos)->solutions.insert((*pos)->solutions.begin(), solution);
                                         break;
                                     }
                                 }
@@ -927,17 +915,17 @@
                         else if(hasLevel3WinningThreat(col, row + 2) && hasLevel3WinningThreat(col2, row2 + 2))
                         {
                             solution->makeGameWinner();
-                            std::list<LineThreat*> additionalSolves;
+                            std::vector<LineThreat*> additionalSolves;
                             for(int r = row + 3; r < 6; ++r)
                                 additionalSolves.insert(additionalSolves.end(), threatBoard[col][r].begin(), threatBoard[col][r].end());
-                            for(std::list<LineThreat*>::iterator pos = additionalSolves.begin(); pos != additionalSolves.end(); ++pos)
+                            for(std::vector<LineThreat*>::iterator pos = additionalSolves.begin(); pos != additionalSolves.end(); ++pos)
                             {
                                 for(int r = row2 + 3; r < 6; ++r)
                                 {
                                     if((*pos)->coversCoords(col2, r))
                                     {
                                         solution->solvedThreats.push_back(*pos);
-                                        (*pos)->solutions.push_front(solution);
+                                        (*pos)->solutions.insert((*pos)->solutions.begin(), solution);
                                         break;
                                     }
                                 }
@@ -945,53 +933,53 @@
                         }
 
                         // Add the threats that are solved by the Verticals
-                        const std::list<LineThreat*>& solvedVerticals1 = threatBoard[col][row + 1];
-                        for(std::list<LineThreat*>::const_iterator pos = solvedVerticals1.begin(); pos != solvedVerticals1.end(); ++pos)
+                        const std::vector<LineThreat*>& solvedVerticals1 = threatBoard[col][row + 1];
+                        for(std::vector<LineThreat*>::const_iterator pos = solvedVerticals1.begin(); pos != solvedVerticals1.end(); ++pos)
                         {
                             if((*pos)->dir == LineThreat::Vertical && (*pos)->startCoords().row != row + 1)
                             {
                                 solution->solvedThreats.push_back(*pos);
                                 if(solution->winsGame())
-                                    (*pos)->solutions.push_front(solution);
+                                    (*pos)->solutions.insert((*pos)->solutions.begin(), solution);
                                 else
                                     (*pos)->solutions.push_back(solution);
                             }
                         }
-                        const std::list<LineThreat*>& solvedVerticals2 = threatBoard[col2][row2 + 1];
-                        for(std::list<LineThreat*>::const_iterator pos = solvedVerticals2.begin(); pos != solvedVerticals2.end(); ++pos)
+                        const std::vector<LineThreat*>& solvedVerticals2 = threatBoard[col2][row2 + 1];
+                        for(std::vector<LineThreat*>::const_iterator pos = solvedVerticals2.begin(); pos != solvedVerticals2.end(); ++pos)
                         {
                             if((*pos)->dir == LineThreat::Vertical && (*pos)->startCoords().row != row2 + 1)
                             {
                                 solution->solvedThreats.push_back(*pos);
                                 if(solution->winsGame())
-                                    (*pos)->solutions.push_front(solution);
+                                    (*pos)->solutions.insert((*pos)->solutions.begin(), solution);
                                 else
                                     (*pos)->solutions.push_back(solution);
                             }
                         }
 
                         // Add the threats that contain both middle squares
-                        const std::list<LineThreat*>& solvedThreats1 = threatBoard[col][row + 1];
-                        for(std::list<LineThreat*>::const_iterator pos = solvedThreats1.begin(); pos != solvedThreats1.end(); ++pos)
+                        const std::vector<LineThreat*>& solvedThreats1 = threatBoard[col][row + 1];
+                        for(std::vector<LineThreat*>::const_iterator pos = solvedThreats1.begin(); pos != solvedThreats1.end(); ++pos)
                         {
                             if((*pos)->coversCoords(col2, row2 + 1))
                             {
                                 solution->solvedThreats.push_back(*pos);
                                 if(solution->winsGame())
-                                    (*pos)->solutions.push_front(solution);
+                                    (*pos)->solutions.insert((*pos)->solutions.begin(), solution);
                                 else
                                     (*pos)->solutions.push_back(solution);
                             }
                         }
                         // Add the threats that contain both upper squares
-                        const std::list<LineThreat*>& solvedThreats2 = threatBoard[col][row + 2];
-                        for(std::list<LineThreat*>::const_iterator pos = solvedThreats2.begin(); pos != solvedThreats2.end(); ++pos)
+                        const std::vector<LineThreat*>& solvedThreats2 = threatBoard[col][row + 2];
+                        for(std::vector<LineThreat*>::const_iterator pos = solvedThreats2.begin(); pos != solvedThreats2.end(); ++pos)
                         {
                             if((*pos)->coversCoords(col2, row2 + 2))
                             {
                                 solution->solvedThreats.push_back(*pos);
                                 if(solution->winsGame())
-                                    (*pos)->solutions.push_front(solution);
+                                    (*pos)->solutions.insert((*pos)->solutions.begin(), solution);
                                 else
                                     (*pos)->solutions.push_back(solution);
                             }
@@ -1001,14 +989,14 @@
                         // we add all threats that contain both the lower square of the first column and the upper square of the second column
                         if(playableCols[col] == row)
                         {
-                            const std::list<LineThreat*>& solvedThreats = threatBoard[col][row];
-                            for(std::list<LineThreat*>::const_iterator pos = solvedThreats.begin(); pos != solvedThreats.end(); ++pos)
+                            const std::vector<LineThreat*>& solvedThreats = threatBoard[col][row];
+                            for(std::vector<LineThreat*>::const_iterator pos = solvedThreats.begin(); pos != solvedThreats.end(); ++pos)
                             {
                                 if((*pos)->coversCoords(col2, row2 + 2))
                                 {
                                     solution->solvedThreats.push_back(*pos);
                                     if(solution->winsGame())
-                                        (*pos)->solutions.push_front(solution);
+                                        (*pos)->solutions.insert((*pos)->solutions.begin(), solution);
                                     else
                                         (*pos)->solutions.push_back(solution);
                                 }
@@ -1019,14 +1007,14 @@
                         // we add all threats that contain both the lower square of the second column and the upper square of the first column
                         if(playableCols[col2] == row2)
                         {
-                            const std::list<LineThreat*>& solvedThreats = threatBoard[col2][row2];
-                            for(std::list<LineThreat*>::const_iterator pos = solvedThreats.begin(); pos != solvedThreats.end(); ++pos)
+                            const std::vector<LineThreat*>& solvedThreats = threatBoard[col2][row2];
+                            for(std::vector<LineThreat*>::const_iterator pos = solvedThreats.begin(); pos != solvedThreats.end(); ++pos)
                             {
                                 if((*pos)->coversCoords(col, row + 2))
                                 {
                                     solution->solvedThreats.push_back(*pos);
                                     if(solution->winsGame())
-                                        (*pos)->solutions.push_front(solution);
+                                        (*pos)->solutions.insert((*pos)->solutions.begin(), solution);
                                     else
                                         (*pos)->solutions.push_back(solution);
                                 }
@@ -1035,9 +1023,9 @@
 
                         // A solution that solves nothing is of no use
                         if(solution->solvedThreats.size() == 0)
-                            delete solution;
+                            solutionPool.removeLast(solution);
                         else if(solution->winsGame())
-                            solutions.push_front(solution);
+                            solutions.insert(solutions.begin(), solution);
                         else
                             solutions.push_back(solution);
                     }
@@ -1087,16 +1075,16 @@
                     if(square1IsEven)
                     {
                         // Find which threats are solved by the BaseInverse
-                        std::list<LineThreat*> solvedByBaseInverse;
-                        const std::list<LineThreat*>& possibleBaseInverseSolves = threatBoard[col2][playableCols[col2]];
-                        for(std::list<LineThreat*>::const_iterator pos = possibleBaseInverseSolves.begin(); pos != possibleBaseInverseSolves.end(); ++pos)
+                        std::vector<LineThreat*> solvedByBaseInverse;
+                        const std::vector<LineThreat*>& possibleBaseInverseSolves = threatBoard[col2][playableCols[col2]];
+                        for(std::vector<LineThreat*>::const_iterator pos = possibleBaseInverseSolves.begin(); pos != possibleBaseInverseSolves.end(); ++pos)
                         {
                             if((*pos)->coversCoords(col3, playableCols[col3]))
                                 solvedByBaseInverse.push_back(*pos);
                         }
 
                         // First variant of the solution
-                        ThreatSolution* solution1 = new ThreatSolution(ThreatSolution::BaseClaim);
+                        ThreatSolution* solution1 = new(solutionPool.allocate()) ThreatSolution(ThreatSolution::BaseClaim);
                         solution1->addSquare(col, playableCols[col]);
                         solution1->addSquare(col2, playableCols[col2]);
                         solution1->addSquare(col3, playableCols[col3]);
@@ -1106,17 +1094,17 @@
                         if(hasLevel3WinningThreat(col2, playableCols[col2]) && hasLevel3WinningThreat(col, playableCols[col] + 1))
                         {
                             solution1->makeGameWinner();
-                            std::list<LineThreat*> additionalSolves;
+                            std::vector<LineThreat*> additionalSolves;
                             for(int r = playableCols[col] + 2; r < 6; ++r)
                                 additionalSolves.insert(additionalSolves.end(), threatBoard[col][r].begin(), threatBoard[col][r].end());
-                            for(std::list<LineThreat*>::iterator pos = additionalSolves.begin(); pos != additionalSolves.end(); ++pos)
+                            for(std::vector<LineThreat*>::iterator pos = additionalSolves.begin(); pos != additionalSolves.end(); ++pos)
                             {
                                 for(int r = playableCols[col2] + 1; r < 6; ++r)
                                 {
                                     if((*pos)->coversCoords(col2, r))
                                     {
                                         solution1->solvedThreats.push_back(*pos);
-                                        (*pos)->solutions.push_front(solution1);
+                                        (*pos)->solutions.insert((*pos)->solutions.begin(), solution1);
                                         break;
                                     }
                                 }
@@ -1125,37 +1113,37 @@
                         // Checking for a win on the second and third playable sqaure is not necessary
                         // since that would be an AfterBaseInverse which solves all threats and wins the game
 
-                        const std::list<LineThreat*>& solvedThreats1 = threatBoard[col2][playableCols[col2]];
-                        for(std::list<LineThreat*>::const_iterator pos = solvedThreats1.begin(); pos != solvedThreats1.end(); ++pos)
+                        const std::vector<LineThreat*>& solvedThreats1 = threatBoard[col2][playableCols[col2]];
+                        for(std::vector<LineThreat*>::const_iterator pos = solvedThreats1.begin(); pos != solvedThreats1.end(); ++pos)
                         {
                             if((*pos)->coversCoords(col, playableCols[col] + 1))
                             {
                                 solution1->solvedThreats.push_back(*pos);
                                 if(solution1->winsGame())
-                                    (*pos)->solutions.push_front(solution1);
+                                    (*pos)->solutions.insert((*pos)->solutions.begin(), solution1);
                                 else
                                     (*pos)->solutions.push_back(solution1);
                             }
                         }
-                        for(std::list<LineThreat*>::const_iterator pos = solvedByBaseInverse.begin(); pos != solvedByBaseInverse.end(); ++pos)
+                        for(std::vector<LineThreat*>::const_iterator pos = solvedByBaseInverse.begin(); pos != solvedByBaseInverse.end(); ++pos)
                         {
                             solution1->solvedThreats.push_back(*pos);
                             if(solution1->winsGame())
-                                (*pos)->solutions.push_front(solution1);
+                                (*pos)->solutions.insert((*pos)->solutions.begin(), solution1);
                             else
                                 (*pos)->solutions.push_back(solution1);
                         }
 
                         // A solution that solves nothing is of no use
                         if(solution1->solvedThreats.size() == 0)
-                            delete solution1;
+                            solutionPool.removeLast(solution1);
                         else if(solution1->winsGame())
-                            solutions.push_front(solution1);
+                            solutions.insert(solutions.begin(), solution1);
                         else
                             solutions.push_back(solution1);
 
                         // Second variant of the solution
-                        ThreatSolution* solution2 = new ThreatSolution(ThreatSolution::BaseClaim);
+                        ThreatSolution* solution2 = new(solutionPool.allocate()) ThreatSolution(ThreatSolution::BaseClaim);
                         solution2->addSquare(col, playableCols[col]);
                         solution2->addSquare(col2, playableCols[col2]);
                         solution2->addSquare(col3, playableCols[col3]);
@@ -1165,17 +1153,17 @@
                         if(hasLevel3WinningThreat(col3, playableCols[col3]) && hasLevel3WinningThreat(col, playableCols[col] + 1))
                         {
                             solution2->makeGameWinner();
-                            std::list<LineThreat*> additionalSolves;
+                            std::vector<LineThreat*> additionalSolves;
                             for(int r = playableCols[col] + 2; r < 6; ++r)
                                 additionalSolves.insert(additionalSolves.end(), threatBoard[col][r].begin(), threatBoard[col][r].end());
-                            for(std::list<LineThreat*>::iterator pos = additionalSolves.begin(); pos != additionalSolves.end(); ++pos)
+                            for(std::vector<LineThreat*>::iterator pos = additionalSolves.begin(); pos != additionalSolves.end(); ++pos)
                             {
                                 for(int r = playableCols[col3] + 1; r < 6; ++r)
                                 {
                                     if((*pos)->coversCoords(col3, r))
                                     {
                                         solution2->solvedThreats.push_back(*pos);
-                                        (*pos)->solutions.push_front(solution2);
+                                        (*pos)->solutions.insert((*pos)->solutions.begin(), solution2);
                                         break;
                                     }
                                 }
@@ -1184,32 +1172,32 @@
                         // Checking for a win on the second and third playable sqaure is not necessary
                         // since that would be an AfterBaseInverse which solves all threats and wins the game
 
-                        const std::list<LineThreat*>& solvedThreats2 = threatBoard[col3][playableCols[col3]];
-                        for(std::list<LineThreat*>::const_iterator pos = solvedThreats2.begin(); pos != solvedThreats2.end(); ++pos)
+                        const std::vector<LineThreat*>& solvedThreats2 = threatBoard[col3][playableCols[col3]];
+                        for(std::vector<LineThreat*>::const_iterator pos = solvedThreats2.begin(); pos != solvedThreats2.end(); ++pos)
                         {
                             if((*pos)->coversCoords(col, playableCols[col] + 1))
                             {
                                 solution2->solvedThreats.push_back(*pos);
                                 if(solution2->winsGame())
-                                    (*pos)->solutions.push_front(solution2);
+                                    (*pos)->solutions.insert((*pos)->solutions.begin(), solution2);
                                 else
                                     (*pos)->solutions.push_back(solution2);
                             }
                         }
-                        for(std::list<LineThreat*>::const_iterator pos = solvedByBaseInverse.begin(); pos != solvedByBaseInverse.end(); ++pos)
+                        for(std::vector<LineThreat*>::const_iterator pos = solvedByBaseInverse.begin(); pos != solvedByBaseInverse.end(); ++pos)
                         {
                             solution2->solvedThreats.push_back(*pos);
                             if(solution2->winsGame())
-                                (*pos)->solutions.push_front(solution2);
+                                (*pos)->solutions.insert((*pos)->solutions.begin(), solution2);
                             else
                                 (*pos)->solutions.push_back(solution2);
                         }
 
                         // A solution that solves nothing is of no use
                         if(solution2->solvedThreats.size() == 0)
-                            delete solution2;
+                            solutionPool.removeLast(solution2);
                         else if(solution2->winsGame())
-                            solutions.push_front(solution2);
+                            solutions.insert(solutions.begin(), solution2);
                         else
                             solutions.push_back(solution2);
                     }
@@ -1217,16 +1205,16 @@
                     if(square2IsEven)
                     {
                         // Find which threats are solved by the BaseInverse
-                        std::list<LineThreat*> solvedByBaseInverse;
-                        const std::list<LineThreat*>& possibleBaseInverseSolves = threatBoard[col][playableCols[col]];
-                        for(std::list<LineThreat*>::const_iterator pos = possibleBaseInverseSolves.begin(); pos != possibleBaseInverseSolves.end(); ++pos)
+                        std::vector<LineThreat*> solvedByBaseInverse;
+                        const std::vector<LineThreat*>& possibleBaseInverseSolves = threatBoard[col][playableCols[col]];
+                        for(std::vector<LineThreat*>::const_iterator pos = possibleBaseInverseSolves.begin(); pos != possibleBaseInverseSolves.end(); ++pos)
                         {
                             if((*pos)->coversCoords(col3, playableCols[col3]))
                                 solvedByBaseInverse.push_back(*pos);
                         }
 
                         // First variant of the solution
-                        ThreatSolution* solution1 = new ThreatSolution(ThreatSolution::BaseClaim);
+                        ThreatSolution* solution1 = new(solutionPool.allocate()) ThreatSolution(ThreatSolution::BaseClaim);
                         solution1->addSquare(col, playableCols[col]);
                         solution1->addSquare(col2, playableCols[col2]);
                         solution1->addSquare(col3, playableCols[col3]);
@@ -1236,17 +1224,17 @@
                         if(hasLevel3WinningThreat(col, playableCols[col]) && hasLevel3WinningThreat(col2, playableCols[col2] + 1))
                         {
                             solution1->makeGameWinner();
-                            std::list<LineThreat*> additionalSolves;
+                            std::vector<LineThreat*> additionalSolves;
                             for(int r = playableCols[col2] + 2; r < 6; ++r)
                                 additionalSolves.insert(additionalSolves.end(), threatBoard[col2][r].begin(), threatBoard[col2][r].end());
-                            for(std::list<LineThreat*>::iterator pos = additionalSolves.begin(); pos != additionalSolves.end(); ++pos)
+                            for(std::vector<LineThreat*>::iterator pos = additionalSolves.begin(); pos != additionalSolves.end(); ++pos)
                             {
                                 for(int r = playableCols[col] + 1; r < 6; ++r)
                                 {
                                     if((*pos)->coversCoords(col, r))
                                     {
                                         solution1->solvedThreats.push_back(*pos);
-                                        (*pos)->solutions.push_front(solution1);
+                                        (*pos)->solutions.insert((*pos)->solutions.begin(), solution1);
                                         break;
                                     }
                                 }
@@ -1255,37 +1243,37 @@
                         // Checking for a win on the second and third playable sqaure is not necessary
                         // since that would be an AfterBaseInverse which solves all threats and wins the game
 
-                        const std::list<LineThreat*>& solvedThreats1 = threatBoard[col][playableCols[col]];
-                        for(std::list<LineThreat*>::const_iterator pos = solvedThreats1.begin(); pos != solvedThreats1.end(); ++pos)
+                        const std::vector<LineThreat*>& solvedThreats1 = threatBoard[col][playableCols[col]];
+                        for(std::vector<LineThreat*>::const_iterator pos = solvedThreats1.begin(); pos != solvedThreats1.end(); ++pos)
                         {
                             if((*pos)->coversCoords(col2, playableCols[col2] + 1))
                             {
                                 solution1->solvedThreats.push_back(*pos);
                                 if(solution1->winsGame())
-                                    (*pos)->solutions.push_front(solution1);
+                                    (*pos)->solutions.insert((*pos)->solutions.begin(), solution1);
                                 else
                                     (*pos)->solutions.push_back(solution1);
                             }
                         }
-                        for(std::list<LineThreat*>::const_iterator pos = solvedByBaseInverse.begin(); pos != solvedByBaseInverse.end(); ++pos)
+                        for(std::vector<LineThreat*>::const_iterator pos = solvedByBaseInverse.begin(); pos != solvedByBaseInverse.end(); ++pos)
                         {
                             solution1->solvedThreats.push_back(*pos);
                             if(solution1->winsGame())
-                                (*pos)->solutions.push_front(solution1);
+                                (*pos)->solutions.insert((*pos)->solutions.begin(), solution1);
                             else
                                 (*pos)->solutions.push_back(solution1);
                         }
 
                         // A solution that solves nothing is of no use
                         if(solution1->solvedThreats.size() == 0)
-                            delete solution1;
+                            solutionPool.removeLast(solution1);
                         else if(solution1->winsGame())
-                            solutions.push_front(solution1);
+                            solutions.insert(solutions.begin(), solution1);
                         else
                             solutions.push_back(solution1);
 
                         // Second variant of the solution
-                        ThreatSolution* solution2 = new ThreatSolution(ThreatSolution::BaseClaim);
+                        ThreatSolution* solution2 = new(solutionPool.allocate()) ThreatSolution(ThreatSolution::BaseClaim);
                         solution2->addSquare(col, playableCols[col]);
                         solution2->addSquare(col2, playableCols[col2]);
                         solution2->addSquare(col3, playableCols[col3]);
@@ -1295,17 +1283,17 @@
                         if(hasLevel3WinningThreat(col3, playableCols[col3]) && hasLevel3WinningThreat(col2, playableCols[col2] + 1))
                         {
                             solution2->makeGameWinner();
-                            std::list<LineThreat*> additionalSolves;
+                            std::vector<LineThreat*> additionalSolves;
                             for(int r = playableCols[col2] + 2; r < 6; ++r)
                                 additionalSolves.insert(additionalSolves.end(), threatBoard[col2][r].begin(), threatBoard[col2][r].end());
-                            for(std::list<LineThreat*>::iterator pos = additionalSolves.begin(); pos != additionalSolves.end(); ++pos)
+                            for(std::vector<LineThreat*>::iterator pos = additionalSolves.begin(); pos != additionalSolves.end(); ++pos)
                             {
                                 for(int r = playableCols[col3] + 1; r < 6; ++r)
                                 {
                                     if((*pos)->coversCoords(col3, r))
                                     {
                                         solution2->solvedThreats.push_back(*pos);
-                                        (*pos)->solutions.push_front(solution2);
+                                        (*pos)->solutions.insert((*pos)->solutions.begin(), solution2);
                                         break;
                                     }
                                 }
@@ -1314,32 +1302,32 @@
                         // Checking for a win on the second and third playable sqaure is not necessary
                         // since that would be an AfterBaseInverse which solves all threats and wins the game
 
-                        const std::list<LineThreat*>& solvedThreats2 = threatBoard[col3][playableCols[col3]];
-                        for(std::list<LineThreat*>::const_iterator pos = solvedThreats2.begin(); pos != solvedThreats2.end(); ++pos)
+                        const std::vector<LineThreat*>& solvedThreats2 = threatBoard[col3][playableCols[col3]];
+                        for(std::vector<LineThreat*>::const_iterator pos = solvedThreats2.begin(); pos != solvedThreats2.end(); ++pos)
                         {
                             if((*pos)->coversCoords(col2, playableCols[col2] + 1))
                             {
                                 solution2->solvedThreats.push_back(*pos);
                                 if(solution2->winsGame())
-                                    (*pos)->solutions.push_front(solution2);
+                                    (*pos)->solutions.insert((*pos)->solutions.begin(), solution2);
                                 else
                                     (*pos)->solutions.push_back(solution2);
                             }
                         }
-                        for(std::list<LineThreat*>::const_iterator pos = solvedByBaseInverse.begin(); pos != solvedByBaseInverse.end(); ++pos)
+                        for(std::vector<LineThreat*>::const_iterator pos = solvedByBaseInverse.begin(); pos != solvedByBaseInverse.end(); ++pos)
                         {
                             solution2->solvedThreats.push_back(*pos);
                             if(solution2->winsGame())
-                                (*pos)->solutions.push_front(solution2);
+                                (*pos)->solutions.insert((*pos)->solutions.begin(), solution2);
                             else
                                 (*pos)->solutions.push_back(solution2);
                         }
 
                         // A solution that solves nothing is of no use
                         if(solution2->solvedThreats.size() == 0)
-                            delete solution2;
+                            solutionPool.removeLast(solution2);
                         else if(solution2->winsGame())
-                            solutions.push_front(solution2);
+                            solutions.insert(solutions.begin(), solution2);
                         else
                             solutions.push_back(solution2);
                     }
@@ -1347,16 +1335,16 @@
                     if(square3IsEven)
                     {
                         // Find which threats are solved by the BaseInverse
-                        std::list<LineThreat*> solvedByBaseInverse;
-                        const std::list<LineThreat*>& possibleBaseInverseSolves = threatBoard[col2][playableCols[col2]];
-                        for(std::list<LineThreat*>::const_iterator pos = possibleBaseInverseSolves.begin(); pos != possibleBaseInverseSolves.end(); ++pos)
+                        std::vector<LineThreat*> solvedByBaseInverse;
+                        const std::vector<LineThreat*>& possibleBaseInverseSolves = threatBoard[col2][playableCols[col2]];
+                        for(std::vector<LineThreat*>::const_iterator pos = possibleBaseInverseSolves.begin(); pos != possibleBaseInverseSolves.end(); ++pos)
                         {
                             if((*pos)->coversCoords(col, playableCols[col]))
                                 solvedByBaseInverse.push_back(*pos);
                         }
 
                         // First variant of the solution
-                        ThreatSolution* solution1 = new ThreatSolution(ThreatSolution::BaseClaim);
+                        ThreatSolution* solution1 = new(solutionPool.allocate()) ThreatSolution(ThreatSolution::BaseClaim);
                         solution1->addSquare(col, playableCols[col]);
                         solution1->addSquare(col2, playableCols[col2]);
                         solution1->addSquare(col3, playableCols[col3]);
@@ -1366,17 +1354,17 @@
                         if(hasLevel3WinningThreat(col, playableCols[col]) && hasLevel3WinningThreat(col3, playableCols[col3] + 1))
                         {
                             solution1->makeGameWinner();
-                            std::list<LineThreat*> additionalSolves;
+                            std::vector<LineThreat*> additionalSolves;
                             for(int r = playableCols[col3] + 2; r < 6; ++r)
                                 additionalSolves.insert(additionalSolves.end(), threatBoard[col3][r].begin(), threatBoard[col3][r].end());
-                            for(std::list<LineThreat*>::iterator pos = additionalSolves.begin(); pos != additionalSolves.end(); ++pos)
+                            for(std::vector<LineThreat*>::iterator pos = additionalSolves.begin(); pos != additionalSolves.end(); ++pos)
                             {
                                 for(int r = playableCols[col] + 1; r < 6; ++r)
                                 {
                                     if((*pos)->coversCoords(col, r))
                                     {
                                         solution1->solvedThreats.push_back(*pos);
-                                        (*pos)->solutions.push_front(solution1);
+                                        (*pos)->solutions.insert((*pos)->solutions.begin(), solution1);
                                         break;
                                     }
                                 }
@@ -1385,37 +1373,37 @@
                         // Checking for a win on the second and third playable sqaure is not necessary
                         // since that would be an AfterBaseInverse which solves all threats and wins the game
 
-                        const std::list<LineThreat*>& solvedThreats1 = threatBoard[col][playableCols[col]];
-                        for(std::list<LineThreat*>::const_iterator pos = solvedThreats1.begin(); pos != solvedThreats1.end(); ++pos)
+                        const std::vector<LineThreat*>& solvedThreats1 = threatBoard[col][playableCols[col]];
+                        for(std::vector<LineThreat*>::const_iterator pos = solvedThreats1.begin(); pos != solvedThreats1.end(); ++pos)
                         {
                             if((*pos)->coversCoords(col3, playableCols[col3] + 1))
                             {
                                 solution1->solvedThreats.push_back(*pos);
                                 if(solution1->winsGame())
-                                    (*pos)->solutions.push_front(solution1);
+                                    (*pos)->solutions.insert((*pos)->solutions.begin(), solution1);
                                 else
                                     (*pos)->solutions.push_back(solution1);
                             }
                         }
-                        for(std::list<LineThreat*>::const_iterator pos = solvedByBaseInverse.begin(); pos != solvedByBaseInverse.end(); ++pos)
+                        for(std::vector<LineThreat*>::const_iterator pos = solvedByBaseInverse.begin(); pos != solvedByBaseInverse.end(); ++pos)
                         {
                             solution1->solvedThreats.push_back(*pos);
                             if(solution1->winsGame())
-                                (*pos)->solutions.push_front(solution1);
+                                (*pos)->solutions.insert((*pos)->solutions.begin(), solution1);
                             else
                                 (*pos)->solutions.push_back(solution1);
                         }
 
                         // A solution that solves nothing is of no use
                         if(solution1->solvedThreats.size() == 0)
-                            delete solution1;
+                            solutionPool.removeLast(solution1);
                         else if(solution1->winsGame())
-                            solutions.push_front(solution1);
+                            solutions.insert(solutions.begin(), solution1);
                         else
                             solutions.push_back(solution1);
 
                         // Second variant of the solution
-                        ThreatSolution* solution2 = new ThreatSolution(ThreatSolution::BaseClaim);
+                        ThreatSolution* solution2 = new(solutionPool.allocate()) ThreatSolution(ThreatSolution::BaseClaim);
                         solution2->addSquare(col, playableCols[col]);
                         solution2->addSquare(col2, playableCols[col2]);
                         solution2->addSquare(col3, playableCols[col3]);
@@ -1425,17 +1413,17 @@
                         if(hasLevel3WinningThreat(col2, playableCols[col2]) && hasLevel3WinningThreat(col3, playableCols[col3] + 1))
                         {
                             solution2->makeGameWinner();
-                            std::list<LineThreat*> additionalSolves;
+                            std::vector<LineThreat*> additionalSolves;
                             for(int r = playableCols[col3] + 2; r < 6; ++r)
                                 additionalSolves.insert(additionalSolves.end(), threatBoard[col3][r].begin(), threatBoard[col3][r].end());
-                            for(std::list<LineThreat*>::iterator pos = additionalSolves.begin(); pos != additionalSolves.end(); ++pos)
+                            for(std::vector<LineThreat*>::iterator pos = additionalSolves.begin(); pos != additionalSolves.end(); ++pos)
                             {
                                 for(int r = playableCols[col2] + 1; r < 6; ++r)
                                 {
                                     if((*pos)->coversCoords(col2, r))
                                     {
                                         solution2->solvedThreats.push_back(*pos);
-                                        (*pos)->solutions.push_front(solution2);
+                                        (*pos)->solutions.insert((*pos)->solutions.begin(), solution2);
                                         break;
                                     }
                                 }
@@ -1444,32 +1432,32 @@
                         // Checking for a win on the second and third playable sqaure is not necessary
                         // since that would be an AfterBaseInverse which solves all threats and wins the game
 
-                        const std::list<LineThreat*>& solvedThreats2 = threatBoard[col2][playableCols[col2]];
-                        for(std::list<LineThreat*>::const_iterator pos = solvedThreats2.begin(); pos != solvedThreats2.end(); ++pos)
+                        const std::vector<LineThreat*>& solvedThreats2 = threatBoard[col2][playableCols[col2]];
+                        for(std::vector<LineThreat*>::const_iterator pos = solvedThreats2.begin(); pos != solvedThreats2.end(); ++pos)
                         {
                             if((*pos)->coversCoords(col3, playableCols[col3] + 1))
                             {
                                 solution2->solvedThreats.push_back(*pos);
                                 if(solution2->winsGame())
-                                    (*pos)->solutions.push_front(solution2);
+                                    (*pos)->solutions.insert((*pos)->solutions.begin(), solution2);
                                 else
                                     (*pos)->solutions.push_back(solution2);
                             }
                         }
-                        for(std::list<LineThreat*>::const_iterator pos = solvedByBaseInverse.begin(); pos != solvedByBaseInverse.end(); ++pos)
+                        for(std::vector<LineThreat*>::const_iterator pos = solvedByBaseInverse.begin(); pos != solvedByBaseInverse.end(); ++pos)
                         {
                             solution2->solvedThreats.push_back(*pos);
                             if(solution2->winsGame())
-                                (*pos)->solutions.push_front(solution2);
+                                (*pos)->solutions.insert((*pos)->solutions.begin(), solution2);
                             else
                                 (*pos)->solutions.push_back(solution2);
                         }
 
                         // A solution that solves nothing is of no use
                         if(solution2->solvedThreats.size() == 0)
-                            delete solution2;
+                            solutionPool.removeLast(solution2);
                         else if(solution2->winsGame())
-                            solutions.push_front(solution2);
+                            solutions.insert(solutions.begin(), solution2);
                         else
                             solutions.push_back(solution2);
                     }
@@ -1481,7 +1469,7 @@
     {
         PieceCoords coords;
         bool success;
-        for(std::list<LineThreat*>::const_iterator pos = winningThreats.begin(); pos != winningThreats.end(); ++pos)
+        for(std::vector<LineThreat*>::const_iterator pos = winningThreats.begin(); pos != winningThreats.end(); ++pos)
         {
             // Find out whether this solution can be used
             success = true;
@@ -1501,9 +1489,9 @@
             if(success)
             {
                 bool firstSquare = true;
-                std::list<LineThreat*> possibleSolves;
-                std::list<LineThreat*> solvedVertical[4]    = {std::list<LineThreat*>(), std::list<LineThreat*>(), std::list<LineThreat*>(), std::list<LineThreat*>()};
-                std::list<LineThreat*> solvedClaimEven[4]   = {std::list<LineThreat*>(), std::list<LineThreat*>(), std::list<LineThreat*>(), std::list<LineThreat*>()};
+                std::vector<LineThreat*> possibleSolves;
+                std::vector<LineThreat*> solvedVertical[4]    = {std::vector<LineThreat*>(), std::vector<LineThreat*>(), std::vector<LineThreat*>(), std::vector<LineThreat*>()};
+                std::vector<LineThreat*> solvedClaimEven[4]   = {std::vector<LineThreat*>(), std::vector<LineThreat*>(), std::vector<LineThreat*>(), std::vector<LineThreat*>()};
 
                 for(int i = 0; i < 4; ++i)
                 {
@@ -1521,7 +1509,7 @@
                         {
                             // If this isn't the first empty Before square, we check if the threats that we already added also contain this square
                             // If they do, we keep them in the list. If they don't, we remove them from the list
-                            for(std::list<LineThreat*>::iterator pos2 = possibleSolves.begin(); pos2 != possibleSolves.end();)
+                            for(std::vector<LineThreat*>::iterator pos2 = possibleSolves.begin(); pos2 != possibleSolves.end();)
                             {
                                 if((*pos2)->coversCoords(coords.col, coords.row + 1))
                                     ++pos2;
@@ -1536,8 +1524,8 @@
                             solvedClaimEven[i] = threatBoard[coords.col][coords.row];
 
                         // Add all threats that are solved by a Vertical with its lowest square in the Before group
-                        const std::list<LineThreat*>& solvedByVertical = threatBoard[coords.col][coords.row];
-                        for(std::list<LineThreat*>::const_iterator pos = solvedByVertical.begin(); pos != solvedByVertical.end(); ++pos)
+                        const std::vector<LineThreat*>& solvedByVertical = threatBoard[coords.col][coords.row];
+                        for(std::vector<LineThreat*>::const_iterator pos = solvedByVertical.begin(); pos != solvedByVertical.end(); ++pos)
                         {
                             if((*pos)->dir == LineThreat::Vertical && (*pos)->startCoords().row != coords.row)
                                 solvedVertical[i].push_back(*pos);
@@ -1555,7 +1543,7 @@
                 for(int i = 0; i < 15; ++i)
                 {
                     // Create the solution
-                    ThreatSolutionBefore* solution = new ThreatSolutionBefore(ThreatSolution::Before);
+                    ThreatSolutionBefore* solution = new(beforePool.allocate()) ThreatSolutionBefore(ThreatSolution::Before);
 
                     // Check if the solution is possible
                     // That is, when we're not trying to use a square below the Before group that's not empty
@@ -1594,12 +1582,12 @@
                     }
                     if(illegalSolution || isAfterEven)
                     {
-                        delete solution;
+                        beforePool.removeLast(solution);
                         continue;
                     }
 
                     // Add the threats that are solved by Before
-                    for(std::list<LineThreat*>::const_iterator pos2 = possibleSolves.begin(); pos2 != possibleSolves.end(); ++pos2)
+                    for(std::vector<LineThreat*>::const_iterator pos2 = possibleSolves.begin(); pos2 != possibleSolves.end(); ++pos2)
                     {
                         solution->solvedThreats.push_back(*pos2);
                         (*pos2)->solutions.push_back(solution);
@@ -1609,10 +1597,10 @@
                     for(int j = 0; j < 4; ++j)
                     {
                         // Get the right list of threats to add
-                        const std::list<LineThreat*>& currList = i & (1 << j) ? solvedClaimEven[j] : solvedVertical[j];
+                        const std::vector<LineThreat*>& currList = i & (1 << j) ? solvedClaimEven[j] : solvedVertical[j];
 
                         // Add the threats
-                        for(std::list<LineThreat*>::const_iterator pos2 = currList.begin(); pos2 != currList.end(); ++pos2)
+                        for(std::vector<LineThreat*>::const_iterator pos2 = currList.begin(); pos2 != currList.end(); ++pos2)
                         {
                             solution->solvedThreats.push_back(*pos2);
                             (*pos2)->solutions.push_back(solution);
@@ -1621,7 +1609,7 @@
 
                     // A solution that solves nothing is of no use
                     if(solution->solvedThreats.size() == 0)
-                        delete solution;
+                        beforePool.removeLast(solution);
                     else
                         solutions.push_back(solution);
                 }
@@ -1639,8 +1627,8 @@
             const int& row = playableCols[col];
             if(row == -1) continue;
 
-            const std::list<LineThreat*>& winThreats = winningThreatBoard[col][row];
-            for(std::list<LineThreat*>::const_iterator pos = winThreats.begin(); pos != winThreats.end(); ++pos)
+            const std::vector<LineThreat*>& winThreats = winningThreatBoard[col][row];
+            for(std::vector<LineThreat*>::const_iterator pos = winThreats.begin(); pos != winThreats.end(); ++pos)
             {
                 // Check if it's a valid group
                 bool validGroup = true;
@@ -1671,12 +1659,12 @@
 
                     // Find the threats that are solved by this SpecialBefore
                     PieceCoords coords;
-                    std::list<LineThreat*> possibleSolves = threatBoard[col2][row2];
-                    std::list<LineThreat*> solvedByDirectPlayable;
-                    std::list<LineThreat*> solvedVertical[4]    = {std::list<LineThreat*>(), std::list<LineThreat*>(), std::list<LineThreat*>(), std::list<LineThreat*>()};
-                    std::list<LineThreat*> solvedClaimEven[4]   = {std::list<LineThreat*>(), std::list<LineThreat*>(), std::list<LineThreat*>(), std::list<LineThreat*>()};
+                    std::vector<LineThreat*> possibleSolves = threatBoard[col2][row2];
+                    std::vector<LineThreat*> solvedByDirectPlayable;
+                    std::vector<LineThreat*> solvedVertical[4]    = {std::vector<LineThreat*>(), std::vector<LineThreat*>(), std::vector<LineThreat*>(), std::vector<LineThreat*>()};
+                    std::vector<LineThreat*> solvedClaimEven[4]   = {std::vector<LineThreat*>(), std::vector<LineThreat*>(), std::vector<LineThreat*>(), std::vector<LineThreat*>()};
 
-                    for(std::list<LineThreat*>::const_iterator pos2 = possibleSolves.begin(); pos2 != possibleSolves.end(); ++pos2)
+                    for(std::vector<LineThreat*>::const_iterator pos2 = possibleSolves.begin(); pos2 != possibleSolves.end(); ++pos2)
                     {
                         if((*pos2)->coversCoords(col, row))
                             solvedByDirectPlayable.push_back(*pos2);
@@ -1688,7 +1676,7 @@
                         {
                             // If this isn't the first empty SpecialBefore square, we check if the threats that we already added also contain this square
                             // If they do, we keep them in the list. If they don't, we remove them from the list
-                            for(std::list<LineThreat*>::iterator pos2 = possibleSolves.begin(); pos2 != possibleSolves.end();)
+                            for(std::vector<LineThreat*>::iterator pos2 = possibleSolves.begin(); pos2 != possibleSolves.end();)
                             {
                                 if((*pos2)->coversCoords(coords.col, coords.row + 1))
                                     ++pos2;
@@ -1703,8 +1691,8 @@
                                 solvedClaimEven[i] = threatBoard[coords.col][coords.row];
 
                             // Add all threats that are solved by a Vertical with its lowest square in the SpecialBefore group
-                            const std::list<LineThreat*>& solvedByVertical = threatBoard[coords.col][coords.row];
-                            for(std::list<LineThreat*>::const_iterator pos = solvedByVertical.begin(); pos != solvedByVertical.end(); ++pos)
+                            const std::vector<LineThreat*>& solvedByVertical = threatBoard[coords.col][coords.row];
+                            for(std::vector<LineThreat*>::const_iterator pos = solvedByVertical.begin(); pos != solvedByVertical.end(); ++pos)
                             {
                                 if((*pos)->dir == LineThreat::Vertical && (*pos)->startCoords().row != coords.row)
                                     solvedVertical[i].push_back(*pos);
@@ -1721,7 +1709,7 @@
                     for(int i = 0; i < 16; ++i)
                     {
                         // Create the solution
-                        ThreatSolutionBefore* solution = new ThreatSolutionBefore(ThreatSolution::SpecialBefore);
+                        ThreatSolutionBefore* solution = new(beforePool.allocate()) ThreatSolutionBefore(ThreatSolution::SpecialBefore);
                         solution->addSquare(col2, row2);
                         solution->addSpecialSquareColumn(col);
                         solution->addSpecialSquareColumn(col2);
@@ -1759,19 +1747,19 @@
                         }
                         if(illegalSolution)
                         {
-                            delete solution;
+                            beforePool.removeLast(solution);
                             continue;
                         }
 
                         // Add the threats that are solved by the directly playable squares
-                        for(std::list<LineThreat*>::const_iterator pos2 = solvedByDirectPlayable.begin(); pos2 != solvedByDirectPlayable.end(); ++pos2)
+                        for(std::vector<LineThreat*>::const_iterator pos2 = solvedByDirectPlayable.begin(); pos2 != solvedByDirectPlayable.end(); ++pos2)
                         {
                             solution->solvedThreats.push_back(*pos2);
                             (*pos2)->solutions.push_back(solution);
                         }
 
                         // Add the threats that are solved by SpecialBefore
-                        for(std::list<LineThreat*>::const_iterator pos2 = possibleSolves.begin(); pos2 != possibleSolves.end(); ++pos2)
+                        for(std::vector<LineThreat*>::const_iterator pos2 = possibleSolves.begin(); pos2 != possibleSolves.end(); ++pos2)
                         {
                             solution->solvedThreats.push_back(*pos2);
                             (*pos2)->solutions.push_back(solution);
@@ -1781,10 +1769,10 @@
                         for(int j = 0; j < 4; ++j)
                         {
                             // Get the right list of threats to add
-                            const std::list<LineThreat*>& currList = i & (1 << j) ? solvedClaimEven[j] : solvedVertical[j];
+                            const std::vector<LineThreat*>& currList = i & (1 << j) ? solvedClaimEven[j] : solvedVertical[j];
 
                             // Add the threats
-                            for(std::list<LineThreat*>::const_iterator pos2 = currList.begin(); pos2 != currList.end(); ++pos2)
+                            for(std::vector<LineThreat*>::const_iterator pos2 = currList.begin(); pos2 != currList.end(); ++pos2)
                             {
                                 solution->solvedThreats.push_back(*pos2);
                                 (*pos2)->solutions.push_back(solution);
@@ -1793,7 +1781,7 @@
 
                         // A solution that solves nothing is of no use
                         if(solution->solvedThreats.size() == 0)
-                            delete solution;
+                            beforePool.removeLast(solution);
                         else
                             solutions.push_back(solution);
                     }
@@ -1809,7 +1797,7 @@
 
         // Check how many direct playable threats (of level 3) we have
         int directThreats = 0;
-        ThreatSolution* solution = new ThreatSolution(ThreatSolution::AfterBaseInverse);
+        ThreatSolution* solution = new(solutionPool.allocate()) ThreatSolution(ThreatSolution::AfterBaseInverse);
         for(int col = 0; col < 7; ++col)
         {
             if(playableCols[col] == -1) continue;
@@ -1829,12 +1817,12 @@
         if(directThreats == 2)
         {
             solution->solvedThreats = std::vector<LineThreat*>(threats.begin(), threats.end());
-            for(std::list<LineThreat*>::const_iterator pos = threats.begin(); pos != threats.end(); ++pos)
+            for(std::vector<LineThreat*>::const_iterator pos = threats.begin(); pos != threats.end(); ++pos)
                 (*pos)->solutions.push_back(solution);
-            solutions.push_front(solution);
+            solutions.insert(solutions.begin(), solution);
         }
         else
-            delete solution;
+            solutionPool.removeLast(solution);
     }
 
     void BoardExt::findAfterVerticals()
@@ -1852,13 +1840,13 @@
                 // If we've got a direct completable threat and one above it we will win our next move
                 // The opponent can only fill in one threat and we can win on the other threat
                 // Since there are no direct threats of the opponent (this function wouldn't be called if there are) we solve all threats
-                ThreatSolution* solution = new ThreatSolution(ThreatSolution::AfterVertical);
+                ThreatSolution* solution = new(solutionPool.allocate()) ThreatSolution(ThreatSolution::AfterVertical);
                 solution->addSquare(col, playableCols[col]);
                 solution->addSquare(col, playableCols[col] + 1);
                 solution->solvedThreats = std::vector<LineThreat*>(threats.begin(), threats.end());
-                for(std::list<LineThreat*>::const_iterator pos = threats.begin(); pos != threats.end(); ++pos)
+                for(std::vector<LineThreat*>::const_iterator pos = threats.begin(); pos != threats.end(); ++pos)
                     (*pos)->solutions.push_back(solution);
-                solutions.push_front(solution);
+                solutions.insert(solutions.begin(), solution);
             }
         }
     }
@@ -1870,36 +1858,25 @@
         const ThreatSolution* inverse = s1->type == ThreatSolution::LowInverse || s1->type == ThreatSolution::HighInverse ? s1 : s2;
         const ThreatSolution* other = s1->type == ThreatSolution::LowInverse || s1->type == ThreatSolution::HighInverse ? s2 : s1;
 
-        // The squares where the inverse starts
+        // The squares from the bottom up to the upper square of the inverse, in both columns of the inverse
         const int upperRowDelta = inverse->type == ThreatSolution::LowInverse ? 1 : 2;
-        PieceCoords start1(-1, -1);
-        PieceCoords start2(-1, -1);
-        for(unsigned int i = 0; i < inverse->squareCount(); ++i)
+        quint64 belowUpperSquares = 0;
+        for(int col = 0; col < 7; ++col)
         {
-            if(start1.col == -1)
-                start1 = inverse->at(i);
-            else if(start1.col != inverse->at(i).col)
-            {
-                start2 = inverse->at(i);
-                break;
-            }
+            const quint8 rows = inverse->squaresInCol(col);
+            if(rows == 0) continue;
+
+            // All rows up to the lowest square of the inverse in this column plus the delta
+            const quint64 columnSquares = (static_cast<quint64>(rows & -rows) << (upperRowDelta + 1)) - 1;
+            belowUpperSquares |= (columnSquares & 0x3F) << (7 * col);
         }
 
         // Find out if there are any ClaimEvens below one of the starts
-        if(other->type == ThreatSolution::ClaimEven)
-            return (start1.col != other->at(0).col || start1.row + upperRowDelta < other->at(0).row) && (start2.col != other->at(0).col || start2.row + upperRowDelta < other->at(0).row);
-        else if(other->type == ThreatSolution::AfterEven)
-        {
-            for(unsigned int i = 0; i < other->squareCount(); ++i)
-            {
-                if(other->at(i).col == start1.col && other->at(i).row <= start1.row + upperRowDelta)
-                    return false;
-                if(other->at(i).col == start2.col && other->at(i).row <= start2.row + upperRowDelta)
-                    return false;
-            }
-        }
+        if(other->type == ThreatSolution::ClaimEven || other->type == ThreatSolution::AfterEven)
+            return (other->squareMask() & belowUpperSquares) == 0;
         else if(other->type == ThreatSolution::BaseClaim)
         {
+            // The lower square of the ClaimEven is the first square that has a square above it in the same column
             PieceCoords lowerClaimEvenSquare(-1, 0);
             for(unsigned int i = 0; i < other->squareCount(); ++i)
             {
@@ -1907,22 +1884,21 @@
                     break;
                 lowerClaimEvenSquare = other->at(i);
             }
-            return (start1.col != lowerClaimEvenSquare.col || start1.row + upperRowDelta < lowerClaimEvenSquare.row) && (start2.col != lowerClaimEvenSquare.col || start2.row + upperRowDelta < lowerClaimEvenSquare.row);
+            return ((Q_UINT64_C(1) << (lowerClaimEvenSquare.row + 7 * lowerClaimEvenSquare.col)) & belowUpperSquares) == 0;
         }
         else if(other->type == ThreatSolution::Before || other->type == ThreatSolution::SpecialBefore)
         {
             const ThreatSolutionBefore* before = dynamic_cast<const ThreatSolutionBefore*>(other);
             if(before == 0) return true;
 
+            // The squares in the columns in which the Before uses ClaimEvens
+            quint64 claimEvenSquares = 0;
             for(int col = 0; col < 7; ++col)
             {
-                if(!before->claimEvenUsedInCol(col)) continue;
-
-                const int& row = before->lowestUsedSquareInCol(col);
-                if((start1.col == col && row <= start1.row + upperRowDelta) || (start2.col == col && row <= start2.row + upperRowDelta))
-                    return false;
+                if(before->claimEvenUsedInCol(col))
+                    claimEvenSquares |= Q_UINT64_C(0x3F) << (7 * col);
             }
-            return true;
+            return (before->squareMask() & claimEvenSquares & belowUpperSquares) == 0;
         }
 
         return true;
@@ -1934,39 +1910,7 @@
         // The sets of squares must be disjoint
         if(s1->interferes(s2)) return false;
 
-        // Find out which columns the inverse s1 uses
-        int col1 = -1;
-        int col2 = -1;
-        for(unsigned int i = 0; i < s1->squareCount(); ++i)
-        {
-            if(col1 == -1)
-                col1 = s1->at(i).col;
-            else if(s1->at(i).col != col1)
-            {
-                col2 = s1->at(i).col;
-                break;
-            }
-        }
-
-        // Check which columns the inverses share
-        bool col1Found = false;
-        bool col2Found = false;
-        for(unsigned int i = 0; i < s2->squareCount(); ++i)
-        {
-            if(col1 == s2->at(i).col)
-            {
-                col1Found = true;
-                continue;
-            }
-            else if(!col1Found && s2->at(i).col > col1)
-                break;
-
-            if(col2 == s2->at(i).col)
-                col2Found = true;
-            else if(!col2Found && s2->at(i).col > col2)
-                break;
-        }
-
-        // Either col1Found and col2Found have both to be true or both should be false
-        return (col1Found && col2Found) || (!col1Found && !col2Found);
+        // The inverse s2 has to use either both columns of the inverse s1 or none of them
+        const quint8 sharedCols = s1->columnMask() & s2->columnMask();
+        return sharedCols == 0 || sharedCols == s1->columnMask();
     }
@@ -18,10 +18,12 @@
 #ifndef BOARDEXT_H
 #define BOARDEXT_H
 
-#include "gameboard.h"
+#include "board.h"
 #include "linethreat.h"
+#include "objectpool.h"
 #include <QMutex>
-#include <list>
+#include <QtGlobal>
+#include <vector>
 
 class BoardExt : public Board, public QMutex
 {
@@ -42,17 +44,17 @@ class BoardExt : public Board, public QMutex
 
         // Finds all of the opponent's threats
         void searchForThreats();
-        std::list<LineThreat*> threats;
-        const std::list<LineThreat*>& threatsAt(const int& col, const int& row) const;
-        const std::list<LineThreat*>& threatsAt(const PieceCoords& coords) const;
+        std::vector<LineThreat*> threats;
+        const std::vector<LineThreat*>& threatsAt(const int& col, const int& row) const;
+        const std::vector<LineThreat*>& threatsAt(const PieceCoords& coords) const;
         // Convenience function: checks if a threat of level 3 is found at the given position
         bool hasLevel3Threat(const int& col, const int& row) const;
 
         // Finds all of our threats
         void searchForWinningThreats();
-        std::list<LineThreat*> winningThreats;
-        const std::list<LineThreat*>& winningThreatsAt(const int& col, const int& row) const;
-        const std::list<LineThreat*>& winningThreatsAt(const PieceCoords& coords) const;
+        std::vector<LineThreat*> winningThreats;
+        const std::vector<LineThreat*>& winningThreatsAt(const int& col, const int& row) const;
+        const std::vector<LineThreat*>& winningThreatsAt(const PieceCoords& coords) const;
         // Convenience function: checks if a winning threat of level 3 is found at the given position
         bool hasLevel3WinningThreat(const int& col, const int& row) const;
 
@@ -70,17 +72,33 @@ class BoardExt : public Board, public QMutex
 
         // Searches for all possible solutions to every possible threat and lists them in 'solutions'
         void searchSolutions();
-        std::list<ThreatSolution*> solutions;
+        std::vector<ThreatSolution*> solutions;
+        // Whether the two solutions can't be used together
+        bool cantCombine(const ThreatSolution* s1, const ThreatSolution* s2) const;
+        // The solutions that can't be used together with the given solution,
+        // as a bitset of solutionWords() words in which bit n is set for solutions[n]
+        const quint64* cantCombineWith(const ThreatSolution* solution) const;
+        unsigned int solutionWords() const;
 
         bool isRed;                     // Whether the player is red or not
 
     private:
-        typedef std::vector< std::list<LineThreat*> > ThreatBoardCol;
-        typedef std::vector< ThreatBoardCol > ThreatBoard;
+        typedef std::vector<LineThreat*> ThreatBoard[7][6];
         std::vector<int> playableCols;  // The playable columns, the vector has the following format:
                                         //   playableCols[column]    =   if not playable: -1, else the row that's playable in this column
         ThreatBoard threatBoard;        // The opponent's threats on the board, per square
         ThreatBoard winningThreatBoard; // Our threats on the board, per square
+        quint64 level3Threats;          // The squares of the opponent's threats of level 3 (as a ColorBoard)
+        quint64 level3WinningThreats;   // The squares of our threats of level 3 (as a ColorBoard)
+
+        // The threats and solutions are kept in pools, which are cleared instead of deleting every object when the board is searched again
+        ObjectPool<LineThreat> threatPool;              // The opponent's threats
+        ObjectPool<LineThreat> winningThreatPool;       // Our threats
+        ObjectPool<ThreatSolution> solutionPool;        // The solutions, except the Befores and SpecialBefores
+        ObjectPool<ThreatSolutionBefore> beforePool;    // The Befores and SpecialBefores
+
+        std::vector<quint64> cantCombineBits;           // For every solution a bitset of the solutions it can't be combined with
+        unsigned int cantCombineWords;                  // The amount of words of each bitset
 
         int oddThreatCol1;                              // The first column that shouldn't be included in the search for solutions
         int oddThreatCol2;                              // The second column that shouldn't be included in the search for solutions
@@ -95,8 +113,10 @@ class BoardExt : public Board, public QMutex
                                                         //      and the set of columns used by the inverses are disjoint or equal.
         static const char solutionCombinations[11][11];
 
-        bool findThreatsFromPoint(const int& col, const int& row, const LineThreat::Direction& dir);
-        bool findWinningThreatsFromPoint(const int& col, const int& row, const LineThreat::Direction& dir);
+        // Adds a threat of the owner for every group without pieces of the blocker to the list and to the squares of the group
+        // The level of a threat is the amount of pieces of the owner in its group, the squares of the level 3 threats are stored in level3Squares
+        // The threats are allocated in the given pool, the threats of the previous search are removed first
+        void addThreats(const quint64& owner, const quint64& blocker, ObjectPool<LineThreat>& pool, std::vector<LineThreat*>& out, ThreatBoard& squareThreats, quint64& level3Squares);
 
         // Functions that find all possible solutions
         void findClaimEvens();
@@ -0,0 +1,17 @@
+#-------------------------------------------------
+#
+# Generates the 10-ply and 12-ply opening books
+#
+#-------------------------------------------------
+
+QT       += core
+QT       -= gui
+
+TARGET = intellicon-bookgen
+TEMPLATE = app
+CONFIG   += console
+CONFIG   -= app_bundle
+
+include(../engine.pri)
+
+SOURCES += main.cpp
@@ -0,0 +1,362 @@
+/************************************************************************
+* This file is part of IntelliCon.                                      *
+*                                                                       *
+* IntelliCon is free software: you can redistribute it and/or modify    *
+* it under the terms of the GNU General Public License as published by  *
+* the Free Software Foundation, either version 3 of the License, or     *
+* (at your option) any later version.                                   *
+*                                                                       *
+* IntelliCon is distributed in the hope that it will be useful,         *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+* GNU General Public License for more details.                          *
+*                                                                       *
+* You should have received a copy of the GNU General Public License     *
+* along with IntelliCon.  If not, see <http://www.gnu.org/licenses/>.   *
+************************************************************************/
+
+#include <QCoreApplication>
+#include <QStringList>
+#include <QFile>
+#include <QDataStream>
+#include <QTextStream>
+#include <QElapsedTimer>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QMutex>
+#include <QMutexLocker>
+#include <vector>
+#include <algorithm>
+#include "alphabetasearcher.h"
+#include "positiondatabase.h"
+#include "bitboard.h"
+
+// The amount of positions solved by one task
+static const int chunkSize = 256;
+
+// Prints how this program should be used
+void printUsage(QTextStream& out)
+{
+    out<<"Usage: intellicon-bookgen [options]"<<endl
+       <<"Solves all positions with the given amount of pieces and writes their values to a packed position database."<<endl
+       <<"Every solved position is appended to a checkpoint file, so an interrupted run continues where it stopped."<<endl
+       <<endl
+       <<"Options:"<<endl
+       <<"  --pieces <n>           The amount of pieces of the positions: 10 or 12 (default: 10)"<<endl
+       <<"  --output <file>        The packed file to write (default: positions-<n>.pdb)"<<endl
+       <<"  --db-files <prefix>    Also write the positions to <prefix>win-pos.db, <prefix>draw-pos.db and <prefix>loss-pos.db"<<endl
+       <<"  --threads <n>          The amount of positions that are solved at the same time (default: the amount of cores)"<<endl
+       <<"  --limit <n>            Stop after solving n more positions, the book is only written when all positions are solved"<<endl
+       <<"  --tt-size <MB>         The size of the transposition table in megabytes (default: 64)"<<endl
+       <<"  --help                 Show this help"<<endl;
+}
+
+// Finds all positions with the given amount of pieces, only the lowest of the symmetric twins is returned
+// Positions in which a player has already won and positions in which the player to move can win directly are left out
+// The positions are generated one ply at a time, so every position is only expanded once
+std::vector<quint64> generatePositions(const int& pieces)
+{
+    std::vector<quint64> positions(1, 0);
+    for(int ply = 0; ply < pieces; ++ply)
+    {
+        std::vector<quint64> next;
+        next.reserve(positions.size() * 4);
+        for(std::vector<quint64>::const_iterator pos = positions.begin(); pos != positions.end(); ++pos)
+        {
+            const BitBoard board(*pos);
+            for(int col = 0; col < 7; ++col)
+            {
+                if(!board.canMove(col)) continue;
+
+                const BitBoard newBoard(board.move(col));
+                if(newBoard.redHasWon() || newBoard.yellowHasWon()) continue;
+
+                next.push_back(qMin(newBoard.toInt(), newBoard.flip()));
+            }
+        }
+
+        std::sort(next.begin(), next.end());
+        next.erase(std::unique(next.begin(), next.end()), next.end());
+        positions.swap(next);
+    }
+
+    // Positions in which the player to move can win directly are solved by the search immediately, so they're not needed
+    std::vector<quint64>::iterator last = positions.begin();
+    for(std::vector<quint64>::const_iterator pos = positions.begin(); pos != positions.end(); ++pos)
+    {
+        const BitBoard board(*pos);
+        bool canWin = false;
+        for(int col = 0; col < 7 && !canWin; ++col)
+        {
+            if(!board.canMove(col)) continue;
+
+            const BitBoard newBoard(board.move(col));
+            canWin = board.redToMove() ? newBoard.redHasWon() : newBoard.yellowHasWon();
+        }
+
+        if(!canWin)
+            *last++ = *pos;
+    }
+    positions.erase(last, positions.end());
+
+    return positions;
+}
+
+// Finds the exact value of the position (Loss, Draw or Win), ValueUnknown if the search only found a bound
+// The searcher should only use the exact values in the transposition table (see AlphaBetaSearcher::setExactValues()),
+// otherwise a stored DrawWin or DrawLoss is returned as it is
+AlphaBetaSearcher::PositionValue solveExact(AlphaBetaSearcher& searcher, const BitBoard& board)
+{
+    const AlphaBetaSearcher::PositionValue value = AlphaBetaSearcher::getValue(searcher.alphaBeta(MaskBoard(board.toInt()),
+                                                                                                AlphaBetaSearcher::Loss, AlphaBetaSearcher::Win));
+
+    // A bound is never written to the book
+    if(value != AlphaBetaSearcher::Loss && value != AlphaBetaSearcher::Draw && value != AlphaBetaSearcher::Win)
+        return AlphaBetaSearcher::ValueUnknown;
+    return value;
+}
+
+/// The state shared by all tasks
+struct Progress
+{
+    QMutex locker;              // Lock for everything in this struct
+    QFile* checkpoint;          // The checkpoint file, every solved position is appended to it
+    QTextStream* err;           // Used to report the progress
+    QElapsedTimer timer;        // Measures the time since the start of this run
+    int solved;                 // The amount of positions solved by this run
+    int total;                  // The amount of positions this run should solve
+};
+
+// Solves a range of positions and appends the results to the checkpoint file
+class SolveTask : public QRunnable
+{
+    public:
+        SolveTask(const std::vector<quint64>& positions, const int& first, const int& last, Progress& progress)
+        : positions(positions), first(first), last(last), progress(progress) {}
+
+        void run()
+        {
+            // Every task uses its own searcher, the transposition table is shared by all of them
+            // The bounds in the table aren't used, so the full window always gives the exact value
+            AlphaBetaSearcher searcher(BitBoard(0), 0);
+            searcher.setExactValues(true);
+
+            // A record is the position shifted 3 bits to the left, the lowest 3 bits hold the value
+            // Positions of which the value isn't exact get no record, so they're solved again by the next run
+            QByteArray records;
+            QDataStream stream(&records, QIODevice::WriteOnly);
+            int failed = 0;
+            for(int i = first; i < last; ++i)
+            {
+                const AlphaBetaSearcher::PositionValue value = solveExact(searcher, BitBoard(positions[i]));
+                if(value == AlphaBetaSearcher::ValueUnknown)
+                    ++failed;
+                else
+                    stream<<((positions[i] << 3) | value);
+            }
+
+            // Write the records at once, so a crash leaves at most one incomplete record behind
+            QMutexLocker locker(&progress.locker);
+            progress.checkpoint->write(records);
+            progress.checkpoint->flush();
+
+            // Report the progress
+            if(failed > 0)
+                *progress.err<<failed<<" positions could not be solved exactly and are left for the next run"<<endl;
+            progress.solved += last - first;
+            const qint64 elapsed = progress.timer.elapsed();
+            const qint64 remaining = progress.solved == 0 ? 0 : elapsed * (progress.total - progress.solved) / progress.solved;
+            *progress.err<<"Solved "<<progress.solved<<" of "<<progress.total<<" positions ("
+                         <<QString::number(1000.0 * progress.solved / qMax(Q_INT64_C(1), elapsed), 'f', 1)<<" positions/s, "
+                         <<remaining / 1000<<" s remaining)"<<endl;
+        }
+
+    private:
+        const std::vector<quint64>& positions;
+        int first;
+        int last;
+        Progress& progress;
+};
+
+// Reads the checkpoint file, returns the records sorted by position
+std::vector<quint64> readCheckpoint(const QString& fileName)
+{
+    std::vector<quint64> records;
+    QFile file(fileName);
+    if(!file.open(QIODevice::ReadOnly))
+        return records;
+
+    // An incomplete record at the end (of a crashed run) is ignored
+    QDataStream stream(&file);
+    for(qint64 i = 0; i < file.size() / 8; ++i)
+    {
+        quint64 record = 0;
+        stream>>record;
+        records.push_back(record);
+    }
+
+    std::sort(records.begin(), records.end());
+    return records;
+}
+
+// Writes the positions with the given value to a file in the format of the original position database
+bool writeDbFile(const QString& fileName, const PositionDatabase& book, const std::vector<quint64>& positions, const quint64& value)
+{
+    QFile file(fileName);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    QDataStream stream(&file);
+    for(std::vector<quint64>::const_iterator pos = positions.begin(); pos != positions.end(); ++pos)
+    {
+        quint64 positionValue = 0;
+        if(book.probe(*pos, positionValue) && positionValue == value)
+            stream<<*pos;
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    // Parse the arguments
+    int pieces = 10;
+    QString output;
+    QString dbFilesPrefix;
+    int limit = -1;
+    const QStringList args = app.arguments();
+    for(int i = 1; i < args.size(); ++i)
+    {
+        bool ok = true;
+        if(args[i] == "--help" || args[i] == "-h")
+        {
+            printUsage(out);
+            return 0;
+        }
+        else if(args[i] == "--pieces" && i + 1 < args.size())
+        {
+            pieces = args[++i].toInt(&ok);
+            ok = ok && (pieces == 10 || pieces == 12);
+        }
+        else if(args[i] == "--output" && i + 1 < args.size())
+            output = args[++i];
+        else if(args[i] == "--db-files" && i + 1 < args.size())
+            dbFilesPrefix = args[++i];
+        else if(args[i] == "--threads" && i + 1 < args.size())
+        {
+            const int threads = args[++i].toInt(&ok);
+            ok = ok && threads > 0;
+            if(ok)
+                QThreadPool::globalInstance()->setMaxThreadCount(threads);
+        }
+        else if(args[i] == "--limit" && i + 1 < args.size())
+        {
+            limit = args[++i].toInt(&ok);
+            ok = ok && limit >= 0;
+        }
+        else if(args[i] == "--tt-size" && i + 1 < args.size())
+        {
+            const int megabytes = args[++i].toInt(&ok);
+            ok = ok && megabytes > 0;
+            if(ok)
+                AlphaBetaSearcher::setTranspositionTableSize(megabytes);
+        }
+        else
+            ok = false;
+
+        if(!ok)
+        {
+            printUsage(err);
+            return 1;
+        }
+    }
+    if(output.isEmpty())
+        output = QString("positions-%1.pdb").arg(pieces);
+    const QString checkpointName = output + ".checkpoint";
+
+    // The searchers use the 8-ply database and, while generating the 12-ply book, the 10-ply book if it's available
+    // (next to the executable or written to the working directory by an earlier run)
+    // A book with the amount of pieces that's being generated is never used, its positions would only be read back
+    AlphaBetaSearcher::loadPositionDatabase();
+    AlphaBetaSearcher::unloadOpeningBook(pieces);
+    if(pieces == 12 && !AlphaBetaSearcher::openingBookLoaded(10) && QFile::exists("positions-10.pdb"))
+        AlphaBetaSearcher::loadOpeningBook(10, "positions-10.pdb");
+    if(pieces == 10)
+        AlphaBetaSearcher::unloadOpeningBook(12);
+
+    // Find all positions and leave out the ones that are already solved by an earlier run
+    err<<"Generating all positions with "<<pieces<<" pieces..."<<endl;
+    const std::vector<quint64> allPositions = generatePositions(pieces);
+    const std::vector<quint64> records = readCheckpoint(checkpointName);
+    std::vector<quint64> positions;
+    std::vector<quint64>::const_iterator record = records.begin();
+    for(std::vector<quint64>::const_iterator pos = allPositions.begin(); pos != allPositions.end(); ++pos)
+    {
+        while(record != records.end() && (*record >> 3) < *pos)
+            ++record;
+        if(record == records.end() || (*record >> 3) != *pos)
+            positions.push_back(*pos);
+    }
+    err<<allPositions.size()<<" positions, "<<allPositions.size() - positions.size()<<" of them solved by an earlier run"<<endl;
+    if(limit >= 0 && static_cast<int>(positions.size()) > limit)
+        positions.resize(limit);
+
+    // Solve the positions in parallel
+    QFile checkpoint(checkpointName);
+    if(!checkpoint.open(QIODevice::WriteOnly | QIODevice::Append))
+    {
+        err<<"Could not open "<<checkpointName<<endl;
+        return 1;
+    }
+
+    // Cut off an incomplete record left behind by a crashed run
+    checkpoint.resize(checkpoint.size() / 8 * 8);
+
+    Progress progress;
+    progress.checkpoint = &checkpoint;
+    progress.err = &err;
+    progress.solved = 0;
+    progress.total = positions.size();
+    progress.timer.start();
+    for(unsigned int first = 0; first < positions.size(); first += chunkSize)
+        QThreadPool::globalInstance()->start(new SolveTask(positions, first, qMin<int>(first + chunkSize, positions.size()), progress));
+    QThreadPool::globalInstance()->waitForDone();
+    checkpoint.close();
+
+    // Only write the book if all positions are solved
+    const std::vector<quint64> solved = readCheckpoint(checkpointName);
+    if(solved.size() < allPositions.size())
+    {
+        err<<solved.size()<<" of "<<allPositions.size()<<" positions are solved, run again to continue"<<endl;
+        return 0;
+    }
+
+    // Build the book from the records
+    PositionDatabase book;
+    for(std::vector<quint64>::const_iterator pos = solved.begin(); pos != solved.end(); ++pos)
+        book.insert(*pos >> 3, *pos & 7);
+    book.sort();
+    if(!book.save(output))
+    {
+        err<<"Could not write "<<output<<endl;
+        return 1;
+    }
+    err<<"Wrote "<<book.size()<<" positions to "<<output<<endl;
+
+    // Write the files in the original format if they're requested
+    if(!dbFilesPrefix.isEmpty())
+    {
+        if(!writeDbFile(dbFilesPrefix + "win-pos.db", book, allPositions, AlphaBetaSearcher::Win) ||
+           !writeDbFile(dbFilesPrefix + "draw-pos.db", book, allPositions, AlphaBetaSearcher::Draw) ||
+           !writeDbFile(dbFilesPrefix + "loss-pos.db", book, allPositions, AlphaBetaSearcher::Loss))
+        {
+            err<<"Could not write the database files "<<dbFilesPrefix<<"*-pos.db"<<endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,40 @@
+#-------------------------------------------------
+#
+# The engine: everything needed to search for moves
+# Only depends on QtCore, so it can be used without a display
+#
+#-------------------------------------------------
+
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+SOURCES += $$PWD/perfectplayerthread.cpp \
+    $$PWD/boardext.cpp \
+    $$PWD/linethreat.cpp \
+    $$PWD/threatsolution.cpp \
+    $$PWD/movesimulator.cpp \
+    $$PWD/bitboard.cpp \
+    $$PWD/bitops.cpp \
+    $$PWD/maskboard.cpp \
+    $$PWD/alphabetasearcher.cpp \
+    $$PWD/transpositiontable.cpp \
+    $$PWD/positiondatabase.cpp \
+    $$PWD/positioncache.cpp \
+    $$PWD/solver.cpp
+
+HEADERS += $$PWD/board.h \
+    $$PWD/perfectplayerthread.h \
+    $$PWD/boardext.h \
+    $$PWD/linethreat.h \
+    $$PWD/objectpool.h \
+    $$PWD/movesimulator.h \
+    $$PWD/bitboard.h \
+    $$PWD/bitops.h \
+    $$PWD/maskboard.h \
+    $$PWD/alphabetasearcher.h \
+    $$PWD/transpositiontable.h \
+    $$PWD/positiondatabase.h \
+    $$PWD/positioncache.h \
+    $$PWD/solver.h
+
+RESOURCES += $$PWD/database.qrc
@@ -22,18 +22,10 @@
 #include <QPixmap>
 #include <list>
 #include <vector>
+#include "board.h"
 #include "mouseclient.h"
 #include "pieceitem.h"
 
-enum Piece
-{
-    Empty   = 0,
-    Red     = 1,
-    Yellow  = 2
-};
-
-typedef std::vector< std::vector<Piece> > Board;
-
 class GameBoard : public QGraphicsScene
 {
     Q_OBJECT
@@ -35,11 +35,11 @@
 // LineThreat
     // Public:
         LineThreat::LineThreat(const int& startCol, const int& startRow, const Direction& dir, const int& threatLevel)
-            : dir(dir), solved(false), solvedTemp(false), start(startCol, startRow), threatLevel(qMin(3, qMax(0, threatLevel)))
+            : dir(dir), solved(false), index(0), start(startCol, startRow), threatLevel(qMin(3, qMax(0, threatLevel)))
         {}
 
         LineThreat::LineThreat(const PieceCoords& startCoords, const Direction& dir, const int& threatLevel)
-        : dir(dir), solved(false), solvedTemp(false), start(startCoords), threatLevel(qMin(3, qMax(0, threatLevel)))
+        : dir(dir), solved(false), index(0), start(startCoords), threatLevel(qMin(3, qMax(0, threatLevel)))
         {}
 
         bool LineThreat::operator==(const LineThreat& other) const
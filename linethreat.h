@@ -18,8 +18,8 @@
 #ifndef LINETHREAD_H
 #define LINETHREAD_H
 
+#include <QtGlobal>
 #include <vector>
-#include <list>
 
 class ThreatSolution;
 
@@ -66,10 +66,10 @@ class LineThreat
         int level() const;
         void setLevel(const int& newThreatLevel);
 
-        std::list<ThreatSolution*> solutions;
+        std::vector<ThreatSolution*> solutions;
 
         bool solved;            // Whether this threat is solved or not
-        bool solvedTemp;        // Temporarily marks this threat as solved
+        unsigned int index;     // The place of this threat in the threats of the board, set by BoardExt::searchSolutions()
 
     private:
         PieceCoords start;
@@ -95,11 +95,12 @@ class ThreatSolution
         };
 
         ThreatSolution(const Type& type);
+        virtual ~ThreatSolution();
 
         Type type;
         std::vector<LineThreat*> solvedThreats;
 
-        std::vector<ThreatSolution*> cantCombine;
+        unsigned int index;     // The place of this solution in the solutions of the board, set by BoardExt::searchSolutions()
 
         virtual bool operator==(const ThreatSolution& other) const;
 
@@ -110,6 +111,13 @@ class ThreatSolution
         void addSquare(const PieceCoords& square);
         void addSquare(const int& col, const int& row);
 
+        // The squares used by this solution (as a ColorBoard)
+        quint64 squareMask() const;
+        // The columns used by this solution, bit n is set if column n is used
+        quint8 columnMask() const;
+        // The squares used by this solution in the given column, bit n is set if row n is used
+        quint8 squaresInCol(const int& col) const;
+
         // Returns true if this solution will win the game
         bool winsGame() const;
         // Make this solution a game winner
@@ -121,10 +129,15 @@ class ThreatSolution
         // The squares in a column are not said to interfere if exaclty the same squares are used by both solutions in that column
         bool interferesColumnWise(const ThreatSolution* other) const;
 
-        bool dontUse;
-
     protected:
-        std::vector<PieceCoords> squares;
+        // The most squares a solution uses (a SpecialBefore), so the squares can be stored in the solution itself
+        static const unsigned int MaxSquares = 9;
+
+        PieceCoords squares[MaxSquares];
+        unsigned int squaresUsed;       // The amount of squares used
+        quint64 usedSquares;            // The squares as a ColorBoard
+        quint8 usedCols;                // The columns of the squares
+        quint8 specialCols;             // The columns in which the set of squares must be disjoint (only used by Befores)
         bool win;
 };
 
@@ -137,6 +150,8 @@ class ThreatSolutionBefore : public ThreatSolution
 
         void useClaimEvenIn(const int& col);
         bool claimEvenUsedInCol(const int& col) const;
+        // The columns in which a ClaimEven is used, bit n is set for column n
+        quint8 claimEvenColumns() const;
 
         int lowestUsedSquareInCol(const int& col) const;
 
@@ -144,8 +159,8 @@ class ThreatSolutionBefore : public ThreatSolution
         bool isSpecialSquareColumn(const int& col) const;
 
     private:
-        std::vector<bool> claimEvenUsed;        // In which columns a ClaimEven is used
-        std::vector<bool> specialSquareCols;    // In which columns special squares are used, and therefore in these columns the set of squares must be disjoint
+        quint8 claimEvenCols;           // In which columns a ClaimEven is used
+                                        // In which columns special squares are used is kept in specialCols
 };
 
 #endif // LINETHREAD_H
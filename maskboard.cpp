@@ -0,0 +1,136 @@
+/************************************************************************
+* This file is part of IntelliCon.                                      *
+*                                                                       *
+* IntelliCon is free software: you can redistribute it and/or modify    *
+* it under the terms of the GNU General Public License as published by  *
+* the Free Software Foundation, either version 3 of the License, or     *
+* (at your option) any later version.                                   *
+*                                                                       *
+* IntelliCon is distributed in the hope that it will be useful,         *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+* GNU General Public License for more details.                          *
+*                                                                       *
+* You should have received a copy of the GNU General Public License     *
+* along with IntelliCon.  If not, see <http://www.gnu.org/licenses/>.   *
+************************************************************************/
+
+#include "maskboard.h"
+#include "bitboard.h"
+#include "bitops.h"
+
+// 4432676798593 is in binary: 0000001 0000001 0000001 0000001 0000001 0000001 0000001
+// In other words: the bottom square of every column
+static const quint64 bottomRow = Q_UINT64_C(4432676798593);
+// 283691315109952 is in binary: 1000000 1000000 1000000 1000000 1000000 1000000 1000000
+// In other words: all top-bits
+static const quint64 topBits = Q_UINT64_C(283691315109952);
+// 279258638311359 is in binary: 0111111 0111111 0111111 0111111 0111111 0111111 0111111
+// In other words: all squares of the board (without the top-bits)
+static const quint64 squares = Q_UINT64_C(279258638311359);
+
+// Public:
+    MaskBoard::MaskBoard()
+    : currentBoard(0), maskBoard(0), moves(0)
+    {}
+
+    MaskBoard::MaskBoard(const quint64& boardInt)
+    {
+        // The highest piece of each column is a true bit, fill all squares below it
+        // Every shift is masked, so no bit is shifted into the neighbouring column
+        // (shifting k squares down is only valid for the rows below 7 - k)
+        quint64 filled = boardInt & squares;
+        filled |= (filled >> 1) & squares;
+        filled |= (filled >> 2) & (bottomRow * 31);     // Rows 0 to 4
+        filled |= (filled >> 4) & (bottomRow * 7);      // Rows 0 to 2
+        maskBoard = filled;
+        moves = BitOps::popcount(filled);
+
+        // In columns with a true top-bit the true bits are red, in the other columns the false bits below the highest piece are red
+        // Subtracting the top-bits shifted to the bottom row gives all squares of the columns with a true top-bit
+        const quint64 redTopBits = boardInt & topBits;
+        const quint64 redColumns = redTopBits - (redTopBits >> 6);
+        const quint64 red = filled & ~(boardInt ^ redColumns);
+        currentBoard = moves % 2 == 0 ? red : red ^ filled;
+    }
+
+    quint64 MaskBoard::toInt() const
+    {
+        // Find the highest piece of each column and keep the ones that are red
+        const quint64 red = redToInt();
+        const quint64 highestRed = red & ~(maskBoard >> 1);
+
+        // Move these pieces up to the top-bit of their column
+        // Every shift is masked, so no bit is shifted into the neighbouring column
+        // (shifting k squares up is only valid for the rows from k on)
+        quint64 redTopBits = highestRed;
+        redTopBits |= (redTopBits << 1) & (bottomRow * 126);    // Rows 1 to 6
+        redTopBits |= (redTopBits << 2) & (bottomRow * 124);    // Rows 2 to 6
+        redTopBits |= (redTopBits << 4) & (bottomRow * 112);    // Rows 4 to 6
+        redTopBits &= topBits;
+
+        // Columns with a red top-bit store the red pieces, the other columns store the yellow pieces
+        const quint64 redColumns = redTopBits - (redTopBits >> 6);
+        return redTopBits | (maskBoard & ~(red ^ redColumns));
+    }
+
+    quint64 MaskBoard::redToInt() const
+    { return moves % 2 == 0 ? currentBoard : currentBoard ^ maskBoard; }
+    quint64 MaskBoard::yellowToInt() const
+    { return moves % 2 == 0 ? currentBoard ^ maskBoard : currentBoard; }
+    const quint64& MaskBoard::current() const
+    { return currentBoard; }
+    quint64 MaskBoard::opponent() const
+    { return currentBoard ^ maskBoard; }
+    const quint64& MaskBoard::mask() const
+    { return maskBoard; }
+    quint64 MaskBoard::key() const
+    { return currentBoard + maskBoard; }
+    quint64 MaskBoard::canonicalKey() const
+    {
+        const quint64 out = key();
+        return qMin(out, BitBoard::flip(out));
+    }
+
+    bool MaskBoard::redToMove() const
+    { return moves % 2 == 0; }
+    int MaskBoard::pieceCount() const
+    { return moves; }
+    bool MaskBoard::isFull() const
+    { return moves == 42; }
+
+    bool MaskBoard::canMove(const int& col) const
+    {
+        // If the bit at (5 + 7 * col) is set, then this column is full
+        return !(maskBoard & (Q_UINT64_C(1) << (5 + 7 * col)));
+    }
+
+    int MaskBoard::playableRow(const int& col) const
+    {
+        // The playable square is the lowest empty square of the column
+        // The top-bit is never filled, so there's always an empty square and the row is 6 if the column is full
+        const int row = BitOps::lowestBit(~maskBoard >> 7 * col);
+        return row == 6 ? -1 : row;
+    }
+
+    quint64 MaskBoard::playableSquare(const int& col) const
+    { return (maskBoard + (Q_UINT64_C(1) << 7 * col)) & squares & (Q_UINT64_C(63) << 7 * col); }
+
+    quint64 MaskBoard::playableSquares() const
+    { return (maskBoard + bottomRow) & squares; }
+
+    MaskBoard MaskBoard::move(const int& col) const
+    {
+        MaskBoard out(*this);
+        out.play(col);
+        return out;
+    }
+
+    void MaskBoard::play(const int& col)
+    {
+        // The pieces of the opponent become the pieces of the player to move
+        // The carry of the addition fills the playable square of the column
+        currentBoard ^= maskBoard;
+        maskBoard |= maskBoard + (Q_UINT64_C(1) << 7 * col);
+        ++moves;
+    }
@@ -0,0 +1,91 @@
+/************************************************************************
+* This file is part of IntelliCon.                                      *
+*                                                                       *
+* IntelliCon is free software: you can redistribute it and/or modify    *
+* it under the terms of the GNU General Public License as published by  *
+* the Free Software Foundation, either version 3 of the License, or     *
+* (at your option) any later version.                                   *
+*                                                                       *
+* IntelliCon is distributed in the hope that it will be useful,         *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+* GNU General Public License for more details.                          *
+*                                                                       *
+* You should have received a copy of the GNU General Public License     *
+* along with IntelliCon.  If not, see <http://www.gnu.org/licenses/>.   *
+************************************************************************/
+
+#ifndef MASKBOARD_H
+#define MASKBOARD_H
+
+#include <QtGlobal>
+
+/** MaskBoard: a board stored as two ints, used by the search since every operation takes constant time
+  Both ints use the squares of a ColorBoard (see bitboard.h):
+  - current: a ColorBoard with the pieces of the player to move
+  - mask: the squares that are filled by either player
+
+  The playable square of a column is found by adding the bottom square of that column to the mask:
+  the carry runs through the filled squares and ends up on the first empty square.
+  If a column is full the carry ends up on the top-bit, which is never part of the board.
+
+  Converting from and to a BoardInt is done without looping over the columns.
+**/
+class MaskBoard
+{
+    public:
+        // Constructs an empty board
+        MaskBoard();
+        // Constructs the board from the given BoardInt
+        MaskBoard(const quint64& boardInt);
+
+        // Returns the board as a BoardInt
+        quint64 toInt() const;
+        // Returns the ColorBoard of red
+        quint64 redToInt() const;
+        // Returns the ColorBoard of yellow
+        quint64 yellowToInt() const;
+        // Returns the ColorBoard of the player to move
+        const quint64& current() const;
+        // Returns the ColorBoard of the player that isn't to move
+        quint64 opponent() const;
+        // Returns the squares that are filled by either player
+        const quint64& mask() const;
+        // Returns a key that's unique for this position, it takes just one addition
+        // Within every column current + mask never carries into the next column, so the key uses the same 7 bits per column as a BoardInt
+        // and the key of the mirror image is found with BitBoard::flip()
+        quint64 key() const;
+        // Returns the smallest of the keys of this position and its mirror image, so both positions get the same key
+        quint64 canonicalKey() const;
+
+        // Whether red is to move or not
+        bool redToMove() const;
+        // Returns the amount of pieces on the board
+        int pieceCount() const;
+        // Returns whether the board is completely filled
+        bool isFull() const;
+
+        // Returns whether a move can be made in the given column
+        bool canMove(const int& col) const;
+        // Returns the row of the direct playable square in the given column
+        // Returns -1 if the square isn't playable
+        int playableRow(const int& col) const;
+        // Returns the direct playable square in the given column as a bit, 0 if the column is full
+        quint64 playableSquare(const int& col) const;
+        // Returns the direct playable squares of all columns
+        quint64 playableSquares() const;
+
+        // Returns a new board where the given move is made
+        // Warning, no checks on the validity of the move are done!
+        MaskBoard move(const int& col) const;
+        // Makes the given move on this board
+        // Warning, no checks on the validity of the move are done!
+        void play(const int& col);
+
+    private:
+        quint64 currentBoard;           // The pieces of the player to move
+        quint64 maskBoard;              // The squares that are filled
+        int moves;                      // The amount of pieces on the board
+};
+
+#endif // MASKBOARD_H
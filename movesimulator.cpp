@@ -16,11 +16,13 @@
 ************************************************************************/
 
 #include "movesimulator.h"
+#include "bitboard.h"
+#include "bitops.h"
 #include <QMutexLocker>
 
 // Public:
     MoveSimulator::MoveSimulator(const Board& board, const int& move, const bool& isRed, const MoveSmartness& leastAchievement)
-    : board(board, isRed), move(move), isRed(isRed), keepRunning(0), leastAchievement(leastAchievement), tryYellowSolve(true)
+    : board(board, isRed), move(move), isRed(isRed), keepRunning(0), leastAchievement(leastAchievement), tryYellowSolve(true), threatWords(0), solutionWords(0)
     { setAutoDelete(true); }
 
     void MoveSimulator::run()
@@ -37,8 +39,41 @@
     void MoveSimulator::dontTryYellowSolve()
     { tryYellowSolve = false; }
 
+    void MoveSimulator::clearResultCache()
+    { MoveSimulator::resultCache.clear(); }
+
 // Public slots:
     MoveSmartness MoveSimulator::simulate()
+    {
+        // The same positions are simulated again for every move of the game
+        // The simulators consulting yellow in applyRules() don't benefit: they've no interrupted pointer, so their result is always Unknown,
+        // which isn't stored, and no other simulator stores a result for yellow with AllSolved as least achievement
+        const quint64 key = resultKey();
+        quint64 data;
+        if(MoveSimulator::resultCache.probe(key, data))
+            return static_cast<MoveSmartness>(data);
+
+        const MoveSmartness result = applyRules();
+
+        // Positions with less pieces take more time to simulate, so they're more valuable to keep
+        if(result != Unknown && (keepRunning == 0 || *keepRunning))
+            MoveSimulator::resultCache.store(key, result, 42 - board.pieceCount());
+
+        return result;
+    }
+
+// Private:
+    // Static:
+        // The results of the simulations, 4 MB is enough for the positions of several games
+        TranspositionTable MoveSimulator::resultCache(4);
+
+    quint64 MoveSimulator::resultKey() const
+    {
+        // The BoardInt uses the lowest 49 bits, the other properties are stored above it
+        return BitBoard::board2int(board) | static_cast<quint64>(isRed) << 49 | static_cast<quint64>(tryYellowSolve) << 50 | static_cast<quint64>(leastAchievement) << 51;
+    }
+
+    MoveSmartness MoveSimulator::applyRules()
     {
         // Find playable columns and threats
         board.findPlayableCols();
@@ -65,7 +100,7 @@
             if(keepRunning != 0 && !*keepRunning) return Unknown;
 
             // Try to find a set of solutions
-            const MoveSmartness result = findSolutionSet(board.threats, board.solutions);
+            const MoveSmartness result = findSolutionSet();
             if(keepRunning != 0 && *keepRunning) return result;
         }
         else if(keepRunning != 0 && *keepRunning)
@@ -101,61 +136,84 @@
         return Unknown;
     }
 
-// Private:
-    MoveSmartness MoveSimulator::findSolutionSet(std::list<LineThreat*> threats, const std::list<ThreatSolution*>& solutions)
+    MoveSmartness MoveSimulator::findSolutionSet()
+    {
+        threatWords = board.threats.size() / 64 + 1;   // At least one word, so the search stack is never empty
+        solutionWords = board.solutionWords();
+        const unsigned int levelWords = threatWords + solutionWords;
+
+        // Every level of the search solves at least one threat, so there are at most as many levels as threats (plus the last level, where all threats are solved)
+        searchStack.assign((board.threats.size() + 1) * levelWords, 0);
+        quint64* unsolved = &searchStack[0];
+        quint64* usable = unsolved + threatWords;
+
+        // Fill the bitsets
+        threatSolutions.assign(board.threats.size() * solutionWords, 0);
+        for(std::vector<LineThreat*>::const_iterator pos = board.threats.begin(); pos != board.threats.end(); ++pos)
+        {
+            const unsigned int threat = (*pos)->index;
+            if(!(*pos)->solved)
+                unsolved[threat / 64] |= Q_UINT64_C(1) << (threat % 64);
+
+            for(std::vector<ThreatSolution*>::const_iterator pos2 = (*pos)->solutions.begin(); pos2 != (*pos)->solutions.end(); ++pos2)
+                threatSolutions[threat * solutionWords + (*pos2)->index / 64] |= Q_UINT64_C(1) << ((*pos2)->index % 64);
+        }
+
+        solvedThreats.assign(board.solutions.size() * threatWords, 0);
+        winningSolutions.assign(solutionWords, 0);
+        for(std::vector<ThreatSolution*>::const_iterator pos = board.solutions.begin(); pos != board.solutions.end(); ++pos)
+        {
+            const unsigned int solution = (*pos)->index;
+            usable[solution / 64] |= Q_UINT64_C(1) << (solution % 64);
+            if((*pos)->winsGame())
+                winningSolutions[solution / 64] |= Q_UINT64_C(1) << (solution % 64);
+
+            for(std::vector<LineThreat*>::const_iterator pos2 = (*pos)->solvedThreats.begin(); pos2 != (*pos)->solvedThreats.end(); ++pos2)
+                solvedThreats[solution * threatWords + (*pos2)->index / 64] |= Q_UINT64_C(1) << ((*pos2)->index % 64);
+        }
+
+        return findSolutionSet(0);
+    }
+
+    MoveSmartness MoveSimulator::findSolutionSet(const unsigned int& level)
     {
         // Check if we're not interrupted
         if(keepRunning != 0 && !*keepRunning) return Unknown;
 
-        // Find out which threat is the hardest to solve
-        std::list<LineThreat*>::iterator hardestThreat = threats.end();
-        unsigned int solutionCount = 0;
-        unsigned int tmpCount;
-        for(std::list<LineThreat*>::iterator pos = threats.begin(); pos != threats.end(); ++pos)
-        {
-            if((*pos)->solved || (*pos)->solvedTemp) continue;
+        const unsigned int levelWords = threatWords + solutionWords;
+        const quint64* unsolved = &searchStack[level * levelWords];
+        const quint64* usable = unsolved + threatWords;
 
-            if(hardestThreat == threats.end() || (*pos)->solutions.size() < solutionCount)
-            {
-                hardestThreat = pos;
-                solutionCount = 0;
-                for(std::list<ThreatSolution*>::const_iterator pos2 = (*pos)->solutions.begin(); pos2 != (*pos)->solutions.end(); ++pos2)
-                {
-                    if(!(*pos2)->dontUse) ++solutionCount;
-                }
-            }
-            else
+        // Find out which threat is the hardest to solve, the first threat with the least solutions that can be used
+        int hardestThreat = -1;
+        int solutionCount = 0;
+        for(unsigned int word = 0; word < threatWords && (hardestThreat == -1 || solutionCount > 0); ++word)
+        {
+            for(quint64 bits = unsolved[word]; bits != 0; bits &= bits - 1)
             {
-                tmpCount = 0;
-                for(std::list<ThreatSolution*>::const_iterator pos2 = (*pos)->solutions.begin(); pos2 != (*pos)->solutions.end(); ++pos2)
-                {
-                    if(!(*pos2)->dontUse)
-                    {
-                        if(++tmpCount > solutionCount) break;
-                    }
-                }
-                if(tmpCount < solutionCount)
+                const int threat = word * 64 + BitOps::lowestBit(bits);
+                const quint64* solutions = &threatSolutions[threat * solutionWords];
+                int count = 0;
+                for(unsigned int word2 = 0; word2 < solutionWords; ++word2)
+                    count += BitOps::popcount(solutions[word2] & usable[word2]);
+
+                if(hardestThreat == -1 || count < solutionCount)
                 {
-                    hardestThreat = pos;
-                    solutionCount = tmpCount;
+                    hardestThreat = threat;
+                    solutionCount = count;
+                    if(solutionCount == 0) break;
                 }
             }
-
-            if(solutionCount == 0) break;
         }
 
-        // Check if we're not interrupted
-        if(keepRunning != 0 && !*keepRunning) return Unknown;
-
         // If there is no hardest threat, we're done searching so we've found a solution
-        if(hardestThreat == threats.end())
+        if(hardestThreat == -1)
         {
             if(leastAchievement == AllSolvedWin)
             {
-                for(std::list<ThreatSolution*>::const_iterator pos = solutions.begin(); pos != solutions.end(); ++pos)
+                for(unsigned int word = 0; word < solutionWords; ++word)
                 {
-                    if((*pos)->dontUse) continue;
-                    if((*pos)->winsGame())
+                    if(usable[word] & winningSolutions[word])
                         return AllSolvedWin;
                 }
             }
@@ -166,51 +224,34 @@
         if(solutionCount == 0)
             return NotAllSolved;
 
-        // Remove the threat from the list, effectively marking it as solved
-        LineThreat* threat = *hardestThreat;
-        threats.erase(hardestThreat);
-        threat->solvedTemp = true;
+        // The next level starts with the hardest threat solved
+        quint64* nextUnsolved = &searchStack[(level + 1) * levelWords];
+        quint64* nextUsable = nextUnsolved + threatWords;
 
         // Try all solutions of the hardest threat
         MoveSmartness best = NotAllSolved;
         MoveSmartness result;
-        for(std::list<ThreatSolution*>::iterator pos = threat->solutions.begin(); pos != threat->solutions.end(); ++pos)
+        const LineThreat* threat = board.threats[hardestThreat];
+        for(std::vector<ThreatSolution*>::const_iterator pos = threat->solutions.begin(); pos != threat->solutions.end(); ++pos)
         {
             // Check if we're not interrupted
             if(keepRunning != 0 && !*keepRunning) return Unknown;
 
-            if((*pos)->dontUse) continue;
+            const unsigned int solution = (*pos)->index;
+            if(!(usable[solution / 64] & (Q_UINT64_C(1) << (solution % 64)))) continue;
 
-            // Mark all neighbours as unusable
-            std::vector<ThreatSolution*> cantCombineAdded;
-            cantCombineAdded.reserve((*pos)->cantCombine.size());
-            for(std::vector<ThreatSolution*>::iterator pos2 = (*pos)->cantCombine.begin(); pos2 != (*pos)->cantCombine.end(); ++pos2)
-            {
-                if((*pos2)->dontUse) continue;
-                (*pos2)->dontUse = true;
-                cantCombineAdded.push_back(*pos2);
-            }
+            // The threats solved by this solution are solved, the solutions that can't be combined with it can't be used anymore
+            const quint64* solved = &solvedThreats[solution * threatWords];
+            for(unsigned int word = 0; word < threatWords; ++word)
+                nextUnsolved[word] = unsolved[word] & ~solved[word];
+            nextUnsolved[hardestThreat / 64] &= ~(Q_UINT64_C(1) << (hardestThreat % 64));
 
-            // Mark all connected threats temporarily as solved
-            std::vector<LineThreat*> threatsTempSolved;
-            threatsTempSolved.reserve((*pos)->solvedThreats.size());
-            for(std::vector<LineThreat*>::iterator pos2 = (*pos)->solvedThreats.begin(); pos2 != (*pos)->solvedThreats.end(); ++pos2)
-            {
-                if((*pos2)->solvedTemp) continue;
-                (*pos2)->solvedTemp = true;
-                threatsTempSolved.push_back(*pos2);
-            }
+            const quint64* cantCombine = board.cantCombineWith(*pos);
+            for(unsigned int word = 0; word < solutionWords; ++word)
+                nextUsable[word] = usable[word] & ~cantCombine[word];
 
             // Try to find a solution for the new set of threats, using the new set of solutions
-            result = findSolutionSet(threats, solutions);
-
-            // Remove the temporarily solve from the threats
-            for(std::vector<LineThreat*>::iterator pos2 = threatsTempSolved.begin(); pos2 != threatsTempSolved.end(); ++pos2)
-                (*pos2)->solvedTemp = false;
-
-            // Mark all neighbours as usable again
-            for(std::vector<ThreatSolution*>::iterator pos2 = cantCombineAdded.begin(); pos2 != cantCombineAdded.end(); ++pos2)
-                (*pos2)->dontUse = false;
+            result = findSolutionSet(level + 1);
 
             // If the current result is better than any of the previous results we will use this result
             if(result > best)
@@ -219,7 +260,5 @@
             }
         }
 
-        threat->solvedTemp = false;
-
         return best;
     }
@@ -19,6 +19,7 @@
 #define MOVESIMULATOR_H
 
 #include "boardext.h"
+#include "transpositiontable.h"
 #include <QRunnable>
 #include <QThreadPool>
 
@@ -48,6 +49,10 @@ class MoveSimulator : public QObject, public QRunnable
 
         void dontTryYellowSolve();
 
+        // Removes all results from the result cache
+        // Warning: this may not be called while other threads are simulating moves
+        static void clearResultCache();
+
     public slots:
         MoveSmartness simulate();
 
@@ -64,10 +69,31 @@ class MoveSimulator : public QObject, public QRunnable
 
         bool tryYellowSolve;            // Whether red should consult yellow if he can't solve the board himself
 
+        // The results of earlier simulations (shared by all simulators and threads), stored by resultKey()
+        // Only results of simulations that weren't interrupted are stored, so a result is the same whether it's found in the cache or not
+        static TranspositionTable resultCache;
+        // Returns the key of this simulation in the result cache: the board, the color, whether yellow is consulted and what we try to achieve
+        // The mirror image of the board doesn't share the key, since red's choice of odd threats depends on the order of the columns
+        quint64 resultKey() const;
+        // Applies the strategic rules to the board, this is simulate() without the result cache
+        MoveSmartness applyRules();
+
+        // The search for a set of solutions uses bitsets of the threats and solutions of the board:
+        // bit n of a threat bitset stands for board.threats[n], bit n of a solution bitset for board.solutions[n]
+        unsigned int threatWords;               // The amount of words of a threat bitset
+        unsigned int solutionWords;             // The amount of words of a solution bitset
+        std::vector<quint64> threatSolutions;   // For every threat the solutions that solve it
+        std::vector<quint64> solvedThreats;     // For every solution the threats it solves
+        std::vector<quint64> winningSolutions;  // The solutions that win the game
+        std::vector<quint64> searchStack;       // For every level of the search the unsolved threats followed by the solutions that can still be used
+
         // Searches solutions for the given move
         MoveSmartness findSolutions(const int& move);
+        // Fills the bitsets and searches a set of solutions that solves all threats
+        MoveSmartness findSolutionSet();
         // Recursive function to find a set of solutions that solve all problems
-        MoveSmartness findSolutionSet(std::list<LineThreat*> threats, const std::list<ThreatSolution*>& solutions);
+        // The threats that aren't solved yet and the solutions that can still be used are at the given level of the search stack
+        MoveSmartness findSolutionSet(const unsigned int& level);
 };
 
 #endif // MOVESIMULATOR_H
@@ -0,0 +1,88 @@
+/************************************************************************
+* This file is part of IntelliCon.                                      *
+*                                                                       *
+* IntelliCon is free software: you can redistribute it and/or modify    *
+* it under the terms of the GNU General Public License as published by  *
+* the Free Software Foundation, either version 3 of the License, or     *
+* (at your option) any later version.                                   *
+*                                                                       *
+* IntelliCon is distributed in the hope that it will be useful,         *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+* GNU General Public License for more details.                          *
+*                                                                       *
+* You should have received a copy of the GNU General Public License     *
+* along with IntelliCon.  If not, see <http://www.gnu.org/licenses/>.   *
+************************************************************************/
+
+#ifndef OBJECTPOOL_H
+#define OBJECTPOOL_H
+
+#include <QtGlobal>
+#include <vector>
+#include <new>
+
+/** ObjectPool: keeps objects of one type in blocks of memory, so they don't have to be allocated one by one
+  allocate() returns the memory for the next object, which should be constructed in it right away using placement new:
+      LineThreat* threat = new(pool.allocate()) LineThreat(col, row, dir, level);
+  The objects stay where they are until the pool is cleared, so pointers to them stay valid.
+  clear() destroys all objects at once, but the blocks are kept, so a pool that's filled again doesn't allocate anything.
+**/
+template<class T> class ObjectPool
+{
+    public:
+        ObjectPool()
+        : count(0) {}
+
+        ~ObjectPool()
+        {
+            clear();
+            for(typename std::vector<T*>::iterator pos = blocks.begin(); pos != blocks.end(); ++pos)
+                ::operator delete(*pos);
+        }
+
+        // Returns the memory for a new object, a block is only allocated if all blocks are full
+        void* allocate()
+        {
+            if(count == blocks.size() * BlockSize)
+                blocks.push_back(static_cast<T*>(::operator new(BlockSize * sizeof(T))));
+            T* object = at(count);
+            ++count;
+            return object;
+        }
+
+        // Destroys the object that was allocated last, its memory is used again for the next object
+        void removeLast(T* object)
+        {
+            Q_ASSERT(count > 0 && object == at(count - 1));
+            object->~T();
+            --count;
+        }
+
+        // Destroys all objects
+        void clear()
+        {
+            while(count > 0)
+                at(--count)->~T();
+        }
+
+        // The amount of objects in the pool
+        unsigned int size() const
+        { return count; }
+        // Returns the object that was allocated as the n-th object
+        T* at(const unsigned int& n) const
+        { return blocks[n / BlockSize] + n % BlockSize; }
+
+    private:
+        // The amount of objects per block
+        static const unsigned int BlockSize = 64;
+
+        std::vector<T*> blocks;     // The blocks of memory, each holds BlockSize objects
+        unsigned int count;         // The amount of objects in the pool
+
+        // Copying the pool would copy the pointers to its blocks, so it's not allowed
+        ObjectPool(const ObjectPool& other);
+        ObjectPool& operator=(const ObjectPool& other);
+};
+
+#endif // OBJECTPOOL_H
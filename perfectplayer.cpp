@@ -25,11 +25,23 @@
 
         connect(&threadManager, SIGNAL(started()), &thread, SLOT(searchMove()));
         connect(&thread, SIGNAL(doMove(const int&)), this, SLOT(moveFound(const int&)));
-        connect(&thread, SIGNAL(statusUpdate(const StatusPhase&,const int&)), this, SLOT(statusUpdateReceiver(const StatusPhase&, const int&)));
+        connect(&thread, SIGNAL(statusUpdate(const StatusPhase&,const int&,const AlphaBetaSearcher::Statistics&)), this, SLOT(statusUpdateReceiver(const StatusPhase&, const int&)));
 
         thread.moveToThread(&threadManager);
     }
 
+    void PerfectPlayer::setTimeBudget(const int& msecs)
+    { thread.setTimeBudget(msecs); }
+
+    void PerfectPlayer::setGameClock(const int& msecs)
+    { thread.setGameClock(msecs); }
+
+    void PerfectPlayer::setDistanceScores(const bool& enabled)
+    { thread.setDistanceScores(enabled); }
+
+    void PerfectPlayer::setThreadCount(const int& threads)
+    { thread.setThreadCount(threads); }
+
 // Public slots:
     void PerfectPlayer::move(const Board& b)
     {
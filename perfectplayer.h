@@ -29,6 +29,14 @@ class PerfectPlayer : public Player
     public:
         PerfectPlayer(const QString& name = "", const bool& playerIsRed = true);
 
+        // Limit the time the player may think, see PerfectPlayerThread::setTimeBudget() and PerfectPlayerThread::setGameClock()
+        void setTimeBudget(const int& msecs);
+        void setGameClock(const int& msecs);
+        // Win as fast as possible and lose as slow as possible, see PerfectPlayerThread::setDistanceScores()
+        void setDistanceScores(const bool& enabled);
+        // Sets the amount of threads used by the alpha-beta search, see PerfectPlayerThread::setThreadCount()
+        void setThreadCount(const int& threads);
+
     public slots:
         void move(const Board& b);
         void abortMoveRequest();
@@ -21,22 +21,65 @@
 #include <QFile>
 
 // Public:
+    MoveLatency::MoveLatency()
+    : total(0), budget(0), deadlineReached(false)
+    {
+        for(int phase = 0; phase <= ChoosingAMove; ++phase)
+            phaseTimes[phase] = 0;
+    }
+
     PerfectPlayerThread::PerfectPlayerThread(const bool& isRed)
-    : isRed(isRed), board(isRed), keepRunning(false), simulatorsKeepRunning(false), alphaBetaKeepRunning(false)
+    : isRed(isRed), board(isRed), keepRunning(false), simulatorsKeepRunning(false),
+      timeBudget(0), gameClock(0), clockRemaining(0), deadlineTimer(new QTimer(this)), currentPhase(FindingPlayableCols),
+      distanceScores(false), threadCount(QThreadPool::globalInstance()->maxThreadCount()), alphaBetaBoard(0)
     {
+        for(int col = 0; col < 7; ++col)
+        {
+            alphaBetaKeepRunning[col] = false;
+            alphaBetaSearchers[col] = 0;
+            alphaBetaHelpers[col] = 0;
+        }
+
         qRegisterMetaType<StatusPhase>("MoveSmartness");
+        qRegisterMetaType<AlphaBetaSearcher::Statistics>("AlphaBetaSearcher::Statistics");
+        qRegisterMetaType<MoveLatency>("MoveLatency");
+        qRegisterMetaType<Solver::Result>("Solver::Result");
+
+        deadlineTimer->setSingleShot(true);
+        connect(deadlineTimer, SIGNAL(timeout()), this, SLOT(deadlineReached()));
     }
 
     PerfectPlayerThread::~PerfectPlayerThread()
     {
         // Interrupt all running threads
         simulatorsKeepRunning = false;
-        alphaBetaKeepRunning = false;
+        stopAlphaBeta();
 
         // Wait for all running threads to exit
         QThreadPool::globalInstance()->waitForDone();
     }
 
+    void PerfectPlayerThread::setTimeBudget(const int& msecs)
+    { timeBudget = qMax(0, msecs); }
+
+    void PerfectPlayerThread::setGameClock(const int& msecs)
+    {
+        gameClock = qMax(0, msecs);
+        clockRemaining = gameClock;
+    }
+
+    void PerfectPlayerThread::setDistanceScores(const bool& enabled)
+    { distanceScores = enabled; }
+
+    void PerfectPlayerThread::setThreadCount(const int& threads)
+    {
+        threadCount = qMax(1, threads);
+
+        // Make sure the thread pool can run all searchers at once, otherwise helpers would wait for other searchers to finish
+        if(QThreadPool::globalInstance()->maxThreadCount() < threadCount)
+            QThreadPool::globalInstance()->setMaxThreadCount(threadCount);
+    }
+
 // Public slots:
     void PerfectPlayerThread::setBoard(const Board& b)
     {
@@ -52,13 +95,46 @@
         // Start the searching
         keepRunning = true;
         simulatorsKeepRunning = true;
+        acceptSimulationDone = false;
+        acceptAlphaBetaResults = false;
+        simulationResults.clear();
+        alphaBetaResults.clear();
+        alphaBetaStatistics = AlphaBetaSearcher::Statistics();
         QMutexLocker locker(&board);
 
+        // Start measuring the time
+        deadlineTimer->stop();
+        moveTimer.start();
+        phaseTimer.start();
+        latency = MoveLatency();
+        currentPhase = FindingPlayableCols;
+
         // Find which columns can be played
         if(!keepRunning) return;
-        statusUpdate(FindingPlayableCols);
+        setStatus(FindingPlayableCols);
         board.findPlayableCols();
 
+        // If this is our first move, a new game has started and the game clock starts again
+        int emptySquares = 0;
+        for(int col = 0; col < 7; ++col)
+            emptySquares += board.playableRow(col) == -1 ? 0 : 6 - board.playableRow(col);
+        if(emptySquares >= 41)
+            newGame();
+
+        // Find out how much time we have for this move
+        // With a game clock the remaining time is divided over the moves we may still have to play
+        qint64 budget = timeBudget;
+        if(gameClock > 0)
+        {
+            const qint64 clockBudget = qMax(Q_INT64_C(1), clockRemaining / qMax(1, (emptySquares + 1) / 2));
+            budget = budget > 0 ? qMin(budget, clockBudget) : clockBudget;
+        }
+
+        // Start the deadline timer, it fires in our event loop when the time is up
+        latency.budget = budget;
+        if(budget > 0)
+            deadlineTimer->start(qMax(Q_INT64_C(0), budget - moveTimer.elapsed()));
+
         // If the board is empty and we're red, we'll play the middle square
         bool boardEmpty = true;
         for(int col = 0; col < 7; ++col)
@@ -72,32 +148,32 @@
         if(boardEmpty)
         {
             // Although we're not really TreeSearching, we're doing something that's necessary for the tree search (building the database)
-            statusUpdate(TreeSearching);
+            setStatus(TreeSearching);
 
             // Load some precalculated positions from the database
             if(!AlphaBetaSearcher::positionDatabaseLoaded())
                 AlphaBetaSearcher::loadPositionDatabase();
 
-            doMove(3);
+            makeMove(3);
             return;
         }
 
         // Try to win the game at once
-        statusUpdate(TryingWinningMove);
+        setStatus(TryingWinningMove);
         int move = tryWinningMove();
         if(move != -1 && keepRunning)
         {
-            doMove(move);
+            makeMove(move);
             return;
         }
         else if(!keepRunning) return;
 
         // Try to block direct enemy threats
-        statusUpdate(BlockingLosingMove);
+        setStatus(BlockingLosingMove);
         move = blockEnemyWinningMove();
         if(move != -1 && keepRunning)
         {
-            doMove(move);
+            makeMove(move);
             return;
         }
         else if(!keepRunning) return;
@@ -107,7 +183,7 @@
         unsigned int resultCount = 0;
 
         // Check for each column if solutions can be found
-        statusUpdate(SearchingSolutions, 0);
+        setStatus(SearchingSolutions, 0);
         for(unsigned int col = 0; col < 7; ++col)
         {
             // Check if we're not interrupted
@@ -117,7 +193,7 @@
             if(board.playableRow(col) == -1)
             {
                 simulationResults[col] = Impossible;
-                statusUpdate(SearchingSolutions, ++resultCount);
+                setStatus(SearchingSolutions, ++resultCount);
                 continue;
             }
 
@@ -125,7 +201,7 @@
             if(board.playableRow(col) != 5 && board.hasLevel3Threat(col, board.playableRow(col) + 1))
             {
                 simulationResults[col] = DirectLose;
-                statusUpdate(SearchingSolutions, ++resultCount);
+                setStatus(SearchingSolutions, ++resultCount);
                 continue;
             }
 
@@ -144,7 +220,7 @@
             if(!keepRunning) return;
 
             // Randomly choose a move from the best moves
-            statusUpdate(ChoosingAMove);
+            setStatus(ChoosingAMove);
             std::vector<unsigned int> cols;
             for(int col = 0; col < 7; ++col)
             {
@@ -161,10 +237,30 @@
             }
 
             if(keepRunning)
-                doMove(cols[qrand() % cols.size()]);
+                makeMove(cols[qrand() % cols.size()]);
         }
     }
 
+    void PerfectPlayerThread::analysePosition()
+    {
+        // Wait for any old threads in the ThreadPool to exit, the solver needs all of them
+        QThreadPool::globalInstance()->waitForDone();
+
+        BitBoard bitBoard(0);
+        {
+            QMutexLocker locker(&board);
+            bitBoard.setBitBoard(BitBoard::board2int(board));
+        }
+
+        Solver solver;
+        solver.setThreadCount(threadCount);
+        solver.setExactValues(true);
+        analysisDone(solver.solve(bitBoard));
+    }
+
+    void PerfectPlayerThread::newGame()
+    { clockRemaining = gameClock; }
+
     void PerfectPlayerThread::stop()
     {
         simulatorsKeepRunning = false;
@@ -220,6 +316,140 @@
         return -1;
     }
 
+    void PerfectPlayerThread::setStatus(const StatusPhase& phase, const int& n)
+    {
+        // Add the time spent in the previous phase
+        if(phase != currentPhase)
+        {
+            latency.phaseTimes[currentPhase] += phaseTimer.restart();
+            currentPhase = phase;
+        }
+
+        statusUpdate(phase, n, alphaBetaStatistics);
+    }
+
+    void PerfectPlayerThread::makeMove(const int& col)
+    {
+        // We won't need the deadline anymore
+        deadlineTimer->stop();
+
+        // Report how the time was spent
+        latency.phaseTimes[currentPhase] += phaseTimer.elapsed();
+        latency.total = moveTimer.elapsed();
+        if(gameClock > 0)
+            clockRemaining -= latency.total;
+        latencyReport(latency);
+
+        doMove(col);
+
+        // Write the positions found while searching this move to the cache file (if it's used), so later games can use them
+        AlphaBetaSearcher::flushPositionCache();
+    }
+
+    int PerfectPlayerThread::bestMoveSoFar() const
+    {
+        // If the alpha-beta search has started, choose the best move from its results in the same way alphaBetaDone() does:
+        // An unknown value is better than a loss, of the winning moves we take the one with the smallest depth
+        // and of the moves with another value the one with the greatest depth
+        // Moves of which the search hasn't finished yet are seen as moves with an unknown value,
+        // of those we take the one with the best score of the iterative deepening (if it has reported any)
+        int bestCol = -1;
+        int bestRank = -1;
+        quint16 bestDepth = 0;
+        int bestScore = 0;
+        for(std::map<int, AlphaBetaResult>::const_iterator pos = alphaBetaResults.begin(); pos != alphaBetaResults.end(); ++pos)
+        {
+            const quint16 val = AlphaBetaSearcher::getValue(pos->second.result);
+            const quint16 depth = AlphaBetaSearcher::getDepth(pos->second.result);
+            const int rank = val == AlphaBetaSearcher::ValueUnknown ? 2 * AlphaBetaSearcher::Loss + 1
+                                                                    : 2 * (isRed ? val : AlphaBetaSearcher::Win + AlphaBetaSearcher::Loss - val);
+            const int score = isRed ? pos->second.score : -pos->second.score;
+            const bool winning = val == (isRed ? AlphaBetaSearcher::Win : AlphaBetaSearcher::Loss);
+            if(rank > bestRank || (rank == bestRank && (val == AlphaBetaSearcher::ValueUnknown ? score > bestScore
+                                                                                                : (winning ? depth < bestDepth : depth > bestDepth))))
+            {
+                bestCol = pos->first;
+                bestRank = rank;
+                bestDepth = depth;
+                bestScore = score;
+            }
+        }
+        if(bestCol != -1)
+            return bestCol;
+
+        // Otherwise use the results of the simulations, a simulation that hasn't finished yet counts as NotAllSolved
+        MoveSmartness bestMove = Unknown;
+        for(unsigned int col = 0; col < simulationResults.size(); ++col)
+        {
+            const MoveSmartness result = simulationResults[col] == Unknown ? NotAllSolved : simulationResults[col];
+            if(result > bestMove)
+            {
+                bestMove = result;
+                bestCol = col;
+            }
+        }
+        if(bestCol != -1 && bestMove > DirectLose)
+            return bestCol;
+
+        // If there's no move that doesn't lose directly, we just play any playable column
+        for(int col = 0; col < 7; ++col)
+        {
+            if(board.playableRow(col) != -1)
+                return col;
+        }
+        return -1;
+    }
+
+    bool PerfectPlayerThread::rootBoundUsed() const
+    { return latency.budget == 0 && !distanceScores; }
+
+    void PerfectPlayerThread::startAlphaBetaSearcher(const int& col)
+    {
+        AlphaBetaSearcher* searcher = new AlphaBetaSearcher(alphaBetaBoard.move(col), col);
+        searcher->setInterruptedPointer(&alphaBetaKeepRunning[col]);
+        searcher->setHelperIndex(alphaBetaHelpers[col]++);
+        searcher->setDistanceScores(distanceScores);
+        if(rootBoundUsed())
+            searcher->setRootBound(&alphaBetaBound, isRed);
+        connect(searcher, SIGNAL(done(const int&, const quint16&, const AlphaBetaSearcher::Statistics&)),
+                this, SLOT(alphaBetaDone(const int&, const quint16&, const AlphaBetaSearcher::Statistics&)));
+
+        // If the time for this move is limited, deepen the search one ply at a time until the end of the game,
+        // so the score of the last iteration can be used if the move isn't solved in time
+        if(latency.budget > 0)
+        {
+            searcher->setDepthLimit(42 - alphaBetaBoard.pieceCount() - 1);
+            connect(searcher, SIGNAL(iterationDone(const int&, const int&, const int&)),
+                    this, SLOT(alphaBetaIterationDone(const int&, const int&, const int&)));
+        }
+        QThreadPool::globalInstance()->start(searcher);    // QThreadPool will clean up the searcher when it's done
+        ++alphaBetaSearchers[col];
+    }
+
+    void PerfectPlayerThread::startAlphaBetaHelpers(int count)
+    {
+        // Give the helpers to the moves with the fewest searchers first
+        while(count > 0 && keepRunning)
+        {
+            int helpCol = -1;
+            for(std::map<int, AlphaBetaResult>::const_iterator pos = alphaBetaResults.begin(); pos != alphaBetaResults.end(); ++pos)
+            {
+                if(!pos->second.reported && (helpCol == -1 || alphaBetaSearchers[pos->first] < alphaBetaSearchers[helpCol]))
+                    helpCol = pos->first;
+            }
+            if(helpCol == -1) return;
+
+            startAlphaBetaSearcher(helpCol);
+            --count;
+        }
+    }
+
+    void PerfectPlayerThread::stopAlphaBeta()
+    {
+        for(int col = 0; col < 7; ++col)
+            alphaBetaKeepRunning[col] = false;
+    }
+
 // Private slots:
     void PerfectPlayerThread::simulationDone(const int& col, const MoveSmartness& result)
     {
@@ -241,7 +471,7 @@
         }
 
         // Update the status on how many results we've found
-        statusUpdate(SearchingSolutions, resultCount);
+        setStatus(SearchingSolutions, resultCount);
 
         // If we haven't got all results yet, we keep looking
         // We can stop looking if we've found a perfect move
@@ -264,7 +494,7 @@
             // Therefore calling QThreadPool::globalInstance()->waitForDone() is not necessary
 
             // Update our status
-            statusUpdate(TreeSearching, 0);
+            setStatus(TreeSearching, 0);
 
             // Check if we're not interrupted
             if(!keepRunning) return;
@@ -274,17 +504,25 @@
                 AlphaBetaSearcher::loadPositionDatabase();
 
             // Create a BitBoard
-            const BitBoard bitBoard(BitBoard::board2int(board));
+            alphaBetaBoard.setBitBoard(BitBoard::board2int(board));
 
             // Check if we're not interrupted
             if(!keepRunning) return;
 
             // We will accept results from the alpha-beta searchers and will also keep track of their results
-            alphaBetaKeepRunning = true;
             acceptAlphaBetaResults = true;
             alphaBetaResults.clear();
+            alphaBetaStatistics = AlphaBetaSearcher::Statistics();
+            alphaBetaBound = isRed ? AlphaBetaSearcher::Loss : AlphaBetaSearcher::Win;
+            for(int col = 0; col < 7; ++col)
+            {
+                alphaBetaKeepRunning[col] = true;
+                alphaBetaSearchers[col] = 0;
+                alphaBetaHelpers[col] = 0;
+            }
 
             // Start a thread for each move to solve it using alpha-beta search
+            int started = 0;
             for(int col = 0; col < 7; ++col)
             {
                 // If the move leads to a defeat or is impossible, there is no use in using alpha-beta search on it
@@ -297,20 +535,20 @@
                 alphaBetaResults[col] = AlphaBetaResult();
 
                 // Try to solve the chosen move
-                const BitBoard newBoard = bitBoard.move(col);
-                AlphaBetaSearcher* searcher = new AlphaBetaSearcher(newBoard, col);
-                searcher->setInterruptedPointer(&alphaBetaKeepRunning);
-                connect(searcher, SIGNAL(done(const int&, const quint16&)), this, SLOT(alphaBetaDone(const int&, const quint16&)));
-                QThreadPool::globalInstance()->start(searcher);    // QThreadPool will clean up the searcher when it's done
+                startAlphaBetaSearcher(col);
+                ++started;
             }
 
+            // The remaining threads help solving the moves
+            startAlphaBetaHelpers(threadCount - started);
+
             // Stop here
             return;
         }
 
         // Randomly choose a move from the best moves
         qsrand(time(0));
-        statusUpdate(ChoosingAMove);
+        setStatus(ChoosingAMove);
         std::vector<unsigned int> cols;
         for(int col = 0; col < 7; ++col)
         {
@@ -327,17 +565,26 @@
         }
 
         if(keepRunning)
-            doMove(cols[qrand() % cols.size()]);
+            makeMove(cols[qrand() % cols.size()]);
     }
 
-    void PerfectPlayerThread::alphaBetaDone(const int& col, const quint16& val)
+    void PerfectPlayerThread::alphaBetaDone(const int& col, const quint16& val, const AlphaBetaSearcher::Statistics& stats)
     {
         // If we don't accept alpha-beta results, we stop here
-        if(!acceptAlphaBetaResults) return;
+        // Only the first searcher of a move to finish counts
+        if(!acceptAlphaBetaResults || alphaBetaResults[col].reported) return;
 
-        // Add the result
+        // The searchers only prove whether a move is better than the moves that were solved before it,
+        // so the value may only be a bound (see AlphaBetaSearcher::rootMoveValue())
+        const AlphaBetaSearcher::PositionValue value = rootBoundUsed() ? AlphaBetaSearcher::rootMoveValue(alphaBetaBound, val, isRed) : val;
+
+        // Add the result and the statistics of the search
         alphaBetaResults[col].reported = true;
-        alphaBetaResults[col].result = val;
+        alphaBetaResults[col].result = value;
+        alphaBetaStatistics += stats;
+
+        // The other moves only have to prove whether they're better than this one
+        AlphaBetaSearcher::raiseRootBound(alphaBetaBound, value, isRed);
 
         // Count the results
         unsigned int resultCount = 0;
@@ -363,7 +610,7 @@
         }
 
         // Update our status
-        statusUpdate(TreeSearching, 100 * resultCount / alphaBetaResults.size());
+        setStatus(TreeSearching, 100 * resultCount / alphaBetaResults.size());
 
         // If we're only working on one move, and all moves untill now mean a loss we just choose that move
         // It can't have a worse outcome and it probably has a greater or somewhat equal depth since it's the last thread to report a result
@@ -371,7 +618,7 @@
         {
             // Stop the remaining thread
             acceptAlphaBetaResults = false;
-            alphaBetaKeepRunning = false;
+            stopAlphaBeta();
 
             // Do the move
             if(keepRunning)
@@ -379,51 +626,92 @@
                 for(std::map<int, AlphaBetaResult>::const_iterator pos = alphaBetaResults.begin(); pos != alphaBetaResults.end(); ++pos)
                 {
                     if(!pos->second.reported)
-                        doMove(pos->first);
+                        makeMove(pos->first);
                 }
             }
             return;
         }
 
         // If not all results have been found and no winning move is found, we have to continue searching
-        if(resultCount != alphaBetaResults.size() && AlphaBetaSearcher::getValue(val) != (isRed ? AlphaBetaSearcher::Win : AlphaBetaSearcher::Loss))
+        // With distance scores we also continue after a winning move, another move may win faster
+        // The searchers of this move are stopped, their threads help solving the other moves
+        const bool winning = AlphaBetaSearcher::getValue(value) == (isRed ? AlphaBetaSearcher::Win : AlphaBetaSearcher::Loss);
+        if(resultCount != alphaBetaResults.size() && (!winning || distanceScores))
+        {
+            alphaBetaKeepRunning[col] = false;
+            const int freed = alphaBetaSearchers[col];
+            alphaBetaSearchers[col] = 0;
+            startAlphaBetaHelpers(freed);
             return;
+        }
 
         // Update our status
-        statusUpdate(ChoosingAMove);
+        setStatus(ChoosingAMove);
 
         // Since we've all the results we want, we can stop searching
         acceptAlphaBetaResults = false;
-        alphaBetaKeepRunning = false;
+        stopAlphaBeta();
 
         // If we just found the winning move, we do that move and stop searching
-        if(AlphaBetaSearcher::getValue(val) == isRed ? AlphaBetaSearcher::Win : AlphaBetaSearcher::Loss)
+        if(winning && !distanceScores)
         {
             if(keepRunning)
-                doMove(col);
+                makeMove(col);
             return;
         }
 
         // Loop through all moves and choose the best one
+        const bool bestWinning = bestValue == (isRed ? AlphaBetaSearcher::Win : AlphaBetaSearcher::Loss);
         quint16 bestDepth = 0;
-        int bestCol = 0;
+        int bestCol = -1;
         for(std::map<int, AlphaBetaResult>::const_iterator pos = alphaBetaResults.begin(); pos != alphaBetaResults.end(); ++pos)
         {
             const quint16 currVal = AlphaBetaSearcher::getValue(pos->second.result);
             const quint16 currDepth = AlphaBetaSearcher::getDepth(pos->second.result);
 
-            // We already know what the best value is, just search the one with the greatest depth
-            // Because since we can't make a winning move, we choose the move where it takes the longest to finish the game
-            // By doing so we maximize the chance of the opponent making a mistake
-            if(bestValue == currVal && currDepth > bestDepth)
+            // We already know what the best value is, if it's a win we search the one with the smallest depth (the fastest win)
+            // Otherwise the one with the greatest depth, since we can't make a winning move, we choose the move where
+            // it takes the longest to finish the game, by doing so we maximize the chance of the opponent making a mistake
+            if(bestValue == currVal && (bestCol == -1 || (bestWinning ? currDepth < bestDepth : currDepth > bestDepth)))
             {
                 bestDepth = currDepth;
                 bestCol = pos->first;
             }
         }
+        if(bestCol == -1)
+            bestCol = alphaBetaResults.begin()->first;
 
         // Do the best move
         if(keepRunning)
-            doMove(bestCol);
+            makeMove(bestCol);
         return;
     }
+
+    void PerfectPlayerThread::alphaBetaIterationDone(const int& col, const int& depth, const int& score)
+    {
+        // If we don't accept alpha-beta results, we stop here
+        // The searchers of a move may be at different iterations, the deepest one counts
+        if(!acceptAlphaBetaResults || alphaBetaResults[col].reported || depth < alphaBetaResults[col].scoreDepth) return;
+
+        alphaBetaResults[col].score = score;
+        alphaBetaResults[col].scoreDepth = depth;
+    }
+
+    void PerfectPlayerThread::deadlineReached()
+    {
+        // If we're interrupted or the move has already been played, there's nothing to do
+        if(!keepRunning || (!acceptSimulationDone && !acceptAlphaBetaResults)) return;
+
+        // Stop all searches and ignore any results that are still on their way
+        acceptSimulationDone = false;
+        simulatorsKeepRunning = false;
+        acceptAlphaBetaResults = false;
+        stopAlphaBeta();
+
+        // Play the best move we've found until now
+        setStatus(ChoosingAMove);
+        latency.deadlineReached = true;
+        const int col = bestMoveSoFar();
+        if(col != -1)
+            makeMove(col);
+    }
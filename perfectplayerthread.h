@@ -20,11 +20,15 @@
 
 #include <QObject>
 #include <QThreadPool>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QAtomicInt>
 #include <map>
 #include "boardext.h"
 #include "movesimulator.h"
 #include "bitboard.h"
 #include "alphabetasearcher.h"
+#include "solver.h"
 
 enum StatusPhase
 {
@@ -37,6 +41,18 @@ enum StatusPhase
 };
 Q_DECLARE_METATYPE(StatusPhase)
 
+/// How the time of the search for one move was spent
+struct MoveLatency
+{
+    qint64 phaseTimes[ChoosingAMove + 1];   // The time (in ms) spent in each StatusPhase
+    qint64 total;                           // The time (in ms) it took to find the move
+    qint64 budget;                          // The time (in ms) the search was allowed to take, 0 if there was no limit
+    bool deadlineReached;                   // Whether the move was chosen because the time was up
+
+    MoveLatency();
+};
+Q_DECLARE_METATYPE(MoveLatency)
+
 class PerfectPlayerThread : public QObject
 {
     Q_OBJECT
@@ -45,13 +61,45 @@ class PerfectPlayerThread : public QObject
         PerfectPlayerThread(const bool& isRed);
         ~PerfectPlayerThread();
 
+        // Sets the time (in ms) the search for one move may take, 0 means there is no limit (the default)
+        // When the time is up, the best move found so far is played
+        // The alpha-beta searchers of a move with a time limit use iterative deepening (see AlphaBetaSearcher::setDepthLimit()),
+        // so the moves that aren't solved when the time is up can still be compared by the score of their last iteration
+        // Warning: this may not be called while a move is being searched
+        void setTimeBudget(const int& msecs);
+        // Sets the total time (in ms) all moves of a game may take, 0 means there is no game clock (the default)
+        // The remaining time is divided equally over the moves we may still have to play
+        // Warning: this may not be called while a move is being searched
+        void setGameClock(const int& msecs);
+        // Sets whether the alpha-beta searchers find the exact distance to the end of the game (see AlphaBetaSearcher::setDistanceScores()),
+        // so the player wins as fast as possible and loses as slow as possible, disabled by default
+        // A winning move is only played when all moves are solved then, since another move may win faster
+        // Warning: this may not be called while a move is being searched
+        void setDistanceScores(const bool& enabled);
+        // Sets the amount of alpha-beta searchers that run at the same time, by default the maximum thread count of the global QThreadPool
+        // Every column gets at least one searcher, the remaining searchers help the columns (see AlphaBetaSearcher::setHelperIndex())
+        // When a column is solved its searchers are stopped and the freed threads help the columns that aren't solved yet
+        // Warning: this may not be called while a move is being searched
+        void setThreadCount(const int& threads);
+
     signals:
         void doMove(const int& col);
-        void statusUpdate(const StatusPhase& phase, const int& n = -1);
+        // While tree searching, stats contains the statistics of all searchers that have reported a result for the current move
+        void statusUpdate(const StatusPhase& phase, const int& n = -1, const AlphaBetaSearcher::Statistics& stats = AlphaBetaSearcher::Statistics());
+        // Emitted just before doMove(), tells how much time each phase of the search took
+        void latencyReport(const MoveLatency& latency);
+        // Emitted by analysePosition(), with the exact value, the depth and the expected line of play of every column
+        void analysisDone(const Solver::Result& analysis);
         
     public slots:
         void setBoard(const Board& b);
         void searchMove();
+        // Finds the exact value of every column of the board, instead of only the best move, and emits analysisDone()
+        // The positions found by earlier searches are reused, since the position databases and the transposition table are shared
+        // This blocks until all columns are solved, so it may not be called while a move is being searched
+        void analysePosition();
+        // Resets the game clock, this is done automatically when searchMove() is called for our first move of a game
+        void newGame();
         void stop();
 
     private:
@@ -60,9 +108,40 @@ class PerfectPlayerThread : public QObject
         bool keepRunning;               // Whether we should keep searching for moves (true) or are interrupted (false)
         bool simulatorsKeepRunning;     // Whether the simulators should keep searching for a solution (true) or not (false)
         bool acceptSimulationDone;      // Whether to accept incoming results from simulations
-        bool alphaBetaKeepRunning;      // Whether we should keep searching for moves using alpha-beta (true) or if we interupt that search (false)
+        bool alphaBetaKeepRunning[7];   // Whether we should keep searching each move using alpha-beta (true) or if we interupt that search (false)
         bool acceptAlphaBetaResults;    // Whether we accept incoming results from the alpha-beta search
 
+        int timeBudget;                 // The time (in ms) the search for one move may take, 0 if there is no limit
+        int gameClock;                  // The time (in ms) all moves of a game may take, 0 if there is no game clock
+        qint64 clockRemaining;          // The time (in ms) that's left on the game clock
+        QTimer* deadlineTimer;          // Fires when the time for the current move is up
+        QElapsedTimer moveTimer;        // Measures the time spent on the current move
+        QElapsedTimer phaseTimer;       // Measures the time spent in the current phase
+        StatusPhase currentPhase;       // The phase the search is in
+        MoveLatency latency;            // How the time of the current move is spent until now
+
+        bool distanceScores;            // Whether the alpha-beta searchers find the exact distance to the end of the game
+        int threadCount;                // The amount of alpha-beta searchers that run at the same time
+        BitBoard alphaBetaBoard;        // The position the alpha-beta searchers are searching the moves of
+        int alphaBetaSearchers[7];      // The amount of alpha-beta searchers working on each move
+        int alphaBetaHelpers[7];        // The amount of alpha-beta searchers started for each move, used as helper index
+        QAtomicInt alphaBetaBound;      // The value we're already sure of because of the moves that are solved, shared by all alpha-beta searchers
+
+        // Switches to the given phase and emits statusUpdate()
+        void setStatus(const StatusPhase& phase, const int& n = -1);
+        // Reports the latency of the search and plays the given move
+        void makeMove(const int& col);
+        // Returns the best move according to the results found until now
+        int bestMoveSoFar() const;
+        // Whether the alpha-beta searchers use the shared root bound, the searches by depth or by distance don't
+        bool rootBoundUsed() const;
+        // Starts an alpha-beta searcher for the given move
+        void startAlphaBetaSearcher(const int& col);
+        // Starts the given amount of alpha-beta searchers, divided over the moves that aren't solved yet
+        void startAlphaBetaHelpers(int count);
+        // Interrupts all alpha-beta searchers
+        void stopAlphaBeta();
+
         /// These functions return -1 if no move is found, if a move is found the column of the move is returned
         // Tries to find a move that directly wins the game
         int tryWinningMove();
@@ -71,21 +150,27 @@ class PerfectPlayerThread : public QObject
 
         /// A struct that represents the result of an AlphaBetaSearcher
         /// The result consists out of the result reported by the searcher and a flag indicating whether the result has been reported
+        /// While iterative deepening, the score (from red's point of view) and the depth of the deepest iteration done are kept too
         struct AlphaBetaResult
         {
             bool reported;
             AlphaBetaSearcher::PositionValue result;
+            int score;
+            int scoreDepth;
 
             AlphaBetaResult()
-            : reported(false), result(AlphaBetaSearcher::ValueUnknown) {}
+            : reported(false), result(AlphaBetaSearcher::ValueUnknown), score(0), scoreDepth(0) {}
         };
 
         std::vector<MoveSmartness> simulationResults;       // The results of the move simulations
         std::map<int, AlphaBetaResult> alphaBetaResults;  // The results of the alpha-beta searches
+        AlphaBetaSearcher::Statistics alphaBetaStatistics;  // The summed statistics of the alpha-beta searches that reported a result
 
     private slots:
         void simulationDone(const int& col, const MoveSmartness& result);
-        void alphaBetaDone(const int& col, const quint16& result);
+        void alphaBetaDone(const int& col, const quint16& result, const AlphaBetaSearcher::Statistics& stats);
+        void alphaBetaIterationDone(const int& col, const int& depth, const int& score);
+        void deadlineReached();
 };
 
 #endif // PERFECTPLAYERTHREAD_H
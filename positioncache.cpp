@@ -0,0 +1,276 @@
+/************************************************************************
+* This file is part of IntelliCon.                                      *
+*                                                                       *
+* IntelliCon is free software: you can redistribute it and/or modify    *
+* it under the terms of the GNU General Public License as published by  *
+* the Free Software Foundation, either version 3 of the License, or     *
+* (at your option) any later version.                                   *
+*                                                                       *
+* IntelliCon is distributed in the hope that it will be useful,         *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+* GNU General Public License for more details.                          *
+*                                                                       *
+* You should have received a copy of the GNU General Public License     *
+* along with IntelliCon.  If not, see <http://www.gnu.org/licenses/>.   *
+************************************************************************/
+
+#include "positioncache.h"
+#include <QFile>
+#include <QByteArray>
+#include <QMutexLocker>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+// The header of a cache file
+static const char magic[8] = {'I', 'C', 'C', 'A', 'C', 'H', 'E', '\0'};
+static const quint32 version = 1;
+static const int headerSize = 16;
+static const int recordSize = 16;
+
+// Returns a checksum (32-bit FNV-1a) of the first 12 bytes of a record
+static quint32 checksum(const uchar* record)
+{
+    quint32 hash = 2166136261u;
+    for(int i = 0; i < 12; ++i)
+        hash = (hash ^ record[i]) * 16777619u;
+    return hash;
+}
+
+// Converts an entry to a record
+static void writeRecord(const PositionCache::Entry& entry, uchar* record)
+{
+    qToLittleEndian<quint64>(entry.position, record);
+    qToLittleEndian<quint16>(entry.value, record + 8);
+    qToLittleEndian<quint16>(entry.priority, record + 10);
+    qToLittleEndian<quint32>(checksum(record), record + 12);
+}
+
+// Returns a header for a cache file
+static QByteArray header()
+{
+    uchar bytes[headerSize];
+    std::memcpy(bytes, magic, sizeof(magic));
+    qToLittleEndian<quint32>(version, bytes + 8);
+    qToLittleEndian<quint32>(recordSize, bytes + 12);
+    return QByteArray(reinterpret_cast<const char*>(bytes), headerSize);
+}
+
+// Writes the data of the file to the disk, so it's complete before the file replaces another one
+static bool syncFile(QFile& file)
+{
+    if(!file.flush()) return false;
+#ifdef Q_OS_WIN
+    return _commit(file.handle()) == 0;
+#else
+    return fsync(file.handle()) == 0;
+#endif
+}
+
+// Replaces the file with the temporary file in one step, so after a crash the file is either the old or the new one
+// QFile::rename() doesn't overwrite an existing file, so the old file would have to be removed first
+static bool replaceFile(const QString& tempName, const QString& fileName)
+{
+#ifdef Q_OS_WIN
+    return MoveFileExW(reinterpret_cast<const wchar_t*>(tempName.utf16()), reinterpret_cast<const wchar_t*>(fileName.utf16()),
+                       MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return std::rename(QFile::encodeName(tempName).constData(), QFile::encodeName(fileName).constData()) == 0;
+#endif
+}
+
+// Used to sort the entries by position, keeping the order of the records of the same position
+static bool positionLessThan(const PositionCache::Entry& a, const PositionCache::Entry& b)
+{ return a.position < b.position; }
+
+// Used to sort the entries by descending priority
+static bool priorityGreaterThan(const PositionCache::Entry& a, const PositionCache::Entry& b)
+{ return a.priority > b.priority; }
+
+// Public:
+    PositionCache::PositionCache()
+    : maxEntries(0), count(0)
+    {}
+
+    bool PositionCache::open(const QString& fileName, const int& maxEntries, std::vector<Entry>& entries)
+    {
+        close();
+        this->fileName = fileName;
+        this->maxEntries = qMax(1, maxEntries);
+
+        // Create the file if it doesn't exist yet
+        if(!QFile::exists(fileName))
+        {
+            QFile file(fileName);
+            if(!file.open(QIODevice::WriteOnly) || file.write(header()) != headerSize)
+            {
+                close();
+                return false;
+            }
+            return true;
+        }
+
+        // Read the records that are already in the file
+        std::vector<Entry> records;
+        if(!read(records))
+        {
+            close();
+            return false;
+        }
+
+        // Remove the positions with the lowest priority if the file holds too many
+        if(count > this->maxEntries)
+            compact(records);
+
+        entries.insert(entries.end(), records.begin(), records.end());
+        return true;
+    }
+
+    void PositionCache::close()
+    {
+        QMutexLocker lock(&locker);
+        fileName.clear();
+        maxEntries = 0;
+        count = 0;
+        std::vector<Entry>().swap(pending);
+    }
+
+    bool PositionCache::isOpen() const
+    { return !fileName.isEmpty(); }
+
+    int PositionCache::size() const
+    { return count; }
+
+    void PositionCache::record(const quint64& position, const quint16& value, const quint16& priority)
+    {
+        QMutexLocker lock(&locker);
+
+        // Never remember more positions than the file may hold
+        if(fileName.isEmpty() || static_cast<int>(pending.size()) >= maxEntries) return;
+
+        const Entry entry = {position, value, priority};
+        pending.push_back(entry);
+    }
+
+    bool PositionCache::flush()
+    {
+        // Take the remembered positions, so the searchers can continue recording while we're writing
+        std::vector<Entry> entries;
+        {
+            QMutexLocker lock(&locker);
+            entries.swap(pending);
+        }
+        if(fileName.isEmpty() || entries.empty()) return true;
+
+        // Convert the entries to records
+        QByteArray records(entries.size() * recordSize, '\0');
+        uchar* record = reinterpret_cast<uchar*>(records.data());
+        for(std::vector<Entry>::const_iterator pos = entries.begin(); pos != entries.end(); ++pos, record += recordSize)
+            writeRecord(*pos, record);
+
+        // Append all records with one write, so records of processes sharing the file don't get mixed up
+        QFile file(fileName);
+        if(!file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Unbuffered) || file.write(records) != records.size())
+            return false;
+        count = (file.size() - headerSize) / recordSize;
+        file.close();
+
+        // Remove the positions with the lowest priority if the file holds too many
+        if(count > maxEntries)
+        {
+            std::vector<Entry> all;
+            return read(all) && compact(all);
+        }
+        return true;
+    }
+
+// Private:
+    bool PositionCache::read(std::vector<Entry>& entries)
+    {
+        QFile file(fileName);
+        if(!file.open(QIODevice::ReadOnly))
+            return false;
+
+        // Check the header
+        const QByteArray bytes = file.readAll();
+        const uchar* data = reinterpret_cast<const uchar*>(bytes.constData());
+        if(bytes.size() < headerSize || std::memcmp(data, magic, sizeof(magic)) != 0 ||
+           qFromLittleEndian<quint32>(data + 8) != version || qFromLittleEndian<quint32>(data + 12) != recordSize)
+            return false;
+        file.close();
+
+        // Read the records that have a valid checksum, an incomplete record at the end is ignored
+        count = (bytes.size() - headerSize) / recordSize;
+        entries.reserve(entries.size() + count);
+        for(int i = 0; i < count; ++i)
+        {
+            const uchar* record = data + headerSize + i * recordSize;
+            if(qFromLittleEndian<quint32>(record + 12) != checksum(record)) continue;
+
+            const Entry entry = {qFromLittleEndian<quint64>(record), qFromLittleEndian<quint16>(record + 8), qFromLittleEndian<quint16>(record + 10)};
+            entries.push_back(entry);
+        }
+
+        // Cut off the incomplete record, otherwise the records appended after it would be misaligned
+        if((bytes.size() - headerSize) % recordSize != 0)
+            file.resize(headerSize + static_cast<qint64>(count) * recordSize);
+
+        return true;
+    }
+
+    bool PositionCache::compact(std::vector<Entry>& entries)
+    {
+        // Keep only the last record of every position, that's the one that was written last
+        std::stable_sort(entries.begin(), entries.end(), positionLessThan);
+        std::vector<Entry>::iterator last = entries.begin();
+        for(std::vector<Entry>::const_iterator pos = entries.begin(); pos != entries.end(); ++pos)
+        {
+            if(pos + 1 == entries.end() || (pos + 1)->position != pos->position)
+                *last++ = *pos;
+        }
+        entries.erase(last, entries.end());
+
+        // Keep the entries with the highest priority, leave some room so the next flush doesn't have to compact again
+        const unsigned int keep = qMax(1, maxEntries / 4 * 3);
+        if(entries.size() > keep)
+        {
+            std::nth_element(entries.begin(), entries.begin() + keep, entries.end(), priorityGreaterThan);
+            entries.resize(keep);
+        }
+
+        // Write the entries to a new file, then replace the old file so a crash never leaves a half written cache behind
+        // If anything fails, the old file is kept
+        const QString tempName = fileName + ".tmp";
+        QFile file(tempName);
+        if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+            return false;
+        QByteArray bytes = header();
+        bytes.resize(headerSize + entries.size() * recordSize);
+        uchar* record = reinterpret_cast<uchar*>(bytes.data()) + headerSize;
+        for(std::vector<Entry>::const_iterator pos = entries.begin(); pos != entries.end(); ++pos, record += recordSize)
+            writeRecord(*pos, record);
+        if(file.write(bytes) != bytes.size() || !syncFile(file))
+        {
+            file.remove();
+            return false;
+        }
+        file.close();
+
+        if(!replaceFile(tempName, fileName))
+        {
+            QFile::remove(tempName);
+            return false;
+        }
+
+        count = entries.size();
+        return true;
+    }
@@ -0,0 +1,89 @@
+/************************************************************************
+* This file is part of IntelliCon.                                      *
+*                                                                       *
+* IntelliCon is free software: you can redistribute it and/or modify    *
+* it under the terms of the GNU General Public License as published by  *
+* the Free Software Foundation, either version 3 of the License, or     *
+* (at your option) any later version.                                   *
+*                                                                       *
+* IntelliCon is distributed in the hope that it will be useful,         *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+* GNU General Public License for more details.                          *
+*                                                                       *
+* You should have received a copy of the GNU General Public License     *
+* along with IntelliCon.  If not, see <http://www.gnu.org/licenses/>.   *
+************************************************************************/
+
+#ifndef POSITIONCACHE_H
+#define POSITIONCACHE_H
+
+#include <QtGlobal>
+#include <QString>
+#include <QMutex>
+#include <vector>
+
+/** PositionCache: a file in which the values of positions that took a lot of work to find are kept across processes
+  New positions are collected in memory by record() and appended to the file by flush().
+  Multiple processes may use the same file, every flush appends its records with one write.
+
+  The file starts with a header of 16 bytes: the magic "ICCACHE" followed by a zero byte,
+  the format version (quint32) and the size of a record (quint32).
+  Every record is 16 bytes: the position (quint64), the value (quint16), the priority (quint16)
+  and a checksum of these 12 bytes (quint32). All integers are stored in little endian byte order.
+
+  Since the file is only appended to, a crash can at most leave an incomplete record at the end, which is cut off when
+  the file is opened. Records with a wrong checksum are skipped.
+  If the file holds more than the maximum amount of records, it's compacted: every position is only kept once (the
+  last record wins) and the records with the lowest priority are removed until three quarters of the maximum remain.
+  The compacted records are written to a temporary file that atomically replaces the file, so a crash while compacting
+  leaves the old file behind, which is also kept if the replacement fails.
+  Records appended by another process while the file is compacted may be lost, which is fine for a cache.
+**/
+class PositionCache
+{
+    public:
+        /// A position with its value, the priority decides which entries are kept when the file is compacted
+        struct Entry
+        {
+            quint64 position;
+            quint16 value;
+            quint16 priority;
+        };
+
+        PositionCache();
+
+        // Opens (or creates) the given file that may hold at most maxEntries records, the entries in it are added to entries
+        // Returns false if the file can't be created or isn't a cache file
+        bool open(const QString& fileName, const int& maxEntries, std::vector<Entry>& entries);
+        // Stops using the file, records that aren't flushed yet are lost
+        void close();
+        // Whether a file is opened
+        bool isOpen() const;
+        // The amount of records in the file (when it was last opened or flushed)
+        int size() const;
+
+        // Remembers the given position so it's written by the next flush(), this may be called by multiple threads at once
+        void record(const quint64& position, const quint16& value, const quint16& priority);
+        // Appends the remembered positions to the file, returns false if they can't be written
+        bool flush();
+
+    private:
+        QString fileName;               // The file, empty if no file is opened
+        int maxEntries;                 // The maximum amount of records in the file
+        int count;                      // The amount of records in the file
+        std::vector<Entry> pending;     // The positions that haven't been written yet
+        QMutex locker;                  // Lock for pending
+
+        // Reads all valid records of the file, returns false if the file isn't a cache file
+        bool read(std::vector<Entry>& entries);
+        // Rewrites the file with the given entries, only the last entry of every position is kept
+        // and only the entries with the highest priority if there are too many
+        bool compact(std::vector<Entry>& entries);
+
+        // Disable copying
+        PositionCache(const PositionCache&);
+        PositionCache& operator=(const PositionCache&);
+};
+
+#endif // POSITIONCACHE_H
@@ -0,0 +1,228 @@
+/************************************************************************
+* This file is part of IntelliCon.                                      *
+*                                                                       *
+* IntelliCon is free software: you can redistribute it and/or modify    *
+* it under the terms of the GNU General Public License as published by  *
+* the Free Software Foundation, either version 3 of the License, or     *
+* (at your option) any later version.                                   *
+*                                                                       *
+* IntelliCon is distributed in the hope that it will be useful,         *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+* GNU General Public License for more details.                          *
+*                                                                       *
+* You should have received a copy of the GNU General Public License     *
+* along with IntelliCon.  If not, see <http://www.gnu.org/licenses/>.   *
+************************************************************************/
+
+#include "positiondatabase.h"
+#include <QFile>
+#include <QDataStream>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+
+// The header of a packed file
+static const char magic[8] = {'I', 'C', 'P', 'O', 'S', 'D', 'B', '\0'};
+static const quint32 version = 1;
+static const int headerSize = 16;
+
+// The values are stored in 2 bits: Loss (1), Draw (3) and Win (5) become 0, 1 and 2
+static quint64 encodeValue(const quint64& value)
+{ return (value - 1) / 2; }
+static quint64 decodeValue(const quint64& bits)
+{ return 2 * bits + 1; }
+
+// Public:
+    PositionDatabase::PositionDatabase()
+    : file(0), mapped(0), entries(0), count(0)
+    {}
+
+    PositionDatabase::~PositionDatabase()
+    { clear(); }
+
+    bool PositionDatabase::map(const QString& fileName)
+    {
+        clear();
+
+        // Map the whole file
+        QFile* mapFile = new QFile(fileName);
+        if(!mapFile->open(QIODevice::ReadOnly) || mapFile->size() < headerSize)
+        {
+            delete mapFile;
+            return false;
+        }
+        const uchar* memory = mapFile->map(0, mapFile->size());
+        if(memory == 0)
+        {
+            delete mapFile;
+            return false;
+        }
+
+        // Check the header, the file should contain exactly the amount of entries given in the header
+        const quint32 fileVersion = qFromLittleEndian<quint32>(memory + 8);
+        const quint32 fileCount = qFromLittleEndian<quint32>(memory + 12);
+        if(std::memcmp(memory, magic, sizeof(magic)) != 0 || fileVersion != version ||
+           mapFile->size() != headerSize + static_cast<qint64>(fileCount) * 8)
+        {
+            mapFile->unmap(const_cast<uchar*>(memory));
+            delete mapFile;
+            return false;
+        }
+
+        // Use the entries directly from the mapped memory (the header keeps them aligned at 8 bytes)
+        file = mapFile;
+        mapped = memory;
+        entries = reinterpret_cast<const quint64*>(memory + headerSize);
+        count = fileCount;
+        return true;
+    }
+
+    bool PositionDatabase::loadFiles(const QString& prefix)
+    {
+        clear();
+
+        // The files and the value of the positions in them
+        const QString filenames[] = {"win-pos.db", "draw-pos.db", "loss-pos.db"};
+        const quint64 values[] = {5, 3, 1};
+
+        // Read each file
+        for(int i = 0; i < 3; ++i)
+        {
+            // Open a stream for the file
+            QFile dbFile(prefix + filenames[i]);
+            if(!dbFile.open(QIODevice::ReadOnly))
+            {
+                clear();
+                return false;
+            }
+            QDataStream stream(&dbFile);
+
+            // Read all positions, each file contains 64-bit integers
+            owned.reserve(owned.size() + dbFile.size() / 8);
+            quint64 position = 0;
+            while(!stream.atEnd())
+            {
+                stream>>position;
+                insert(position, values[i]);
+            }
+        }
+
+        // The original files aren't sorted
+        // Note that one position is both in win-pos.db and draw-pos.db, it's seen as a draw
+        sort();
+        return true;
+    }
+
+    void PositionDatabase::insert(const quint64& position, const quint64& value)
+    {
+        // Copy the mapped entries, since the mapped memory is read-only
+        if(file != 0)
+        {
+            std::vector<quint64> copy(count);
+            for(int i = 0; i < count; ++i)
+                copy[i] = entry(i);
+            clear();
+            owned.swap(copy);
+        }
+
+        owned.push_back((position << 2) | encodeValue(value));
+        entries = &owned[0];
+        count = owned.size();
+    }
+
+    void PositionDatabase::sort()
+    {
+        if(file != 0) return;
+
+        std::sort(owned.begin(), owned.end());
+
+        // Only the first entry of a position is kept, which is the one with the lowest value
+        std::vector<quint64>::iterator last = owned.begin();
+        for(std::vector<quint64>::const_iterator pos = owned.begin(); pos != owned.end(); ++pos)
+        {
+            if(last == owned.begin() || (*(last - 1) >> 2) != (*pos >> 2))
+                *last++ = *pos;
+        }
+        owned.erase(last, owned.end());
+
+        entries = owned.empty() ? 0 : &owned[0];
+        count = owned.size();
+    }
+
+    bool PositionDatabase::save(const QString& fileName) const
+    {
+        QFile out(fileName);
+        if(!out.open(QIODevice::WriteOnly | QIODevice::Truncate))
+            return false;
+
+        // Write the header
+        uchar header[headerSize];
+        std::memcpy(header, magic, sizeof(magic));
+        qToLittleEndian<quint32>(version, header + 8);
+        qToLittleEndian<quint32>(count, header + 12);
+        if(out.write(reinterpret_cast<const char*>(header), headerSize) != headerSize)
+            return false;
+
+        // Write the entries
+        for(int i = 0; i < count; ++i)
+        {
+            uchar bytes[8];
+            qToLittleEndian<quint64>(entry(i), bytes);
+            if(out.write(reinterpret_cast<const char*>(bytes), 8) != 8)
+                return false;
+        }
+
+        return true;
+    }
+
+    void PositionDatabase::clear()
+    {
+        if(file != 0)
+        {
+            file->unmap(const_cast<uchar*>(mapped));
+            delete file;
+        }
+        file = 0;
+        mapped = 0;
+        std::vector<quint64>().swap(owned);
+        entries = 0;
+        count = 0;
+    }
+
+    bool PositionDatabase::isLoaded() const
+    { return count != 0; }
+
+    bool PositionDatabase::isMapped() const
+    { return file != 0; }
+
+    int PositionDatabase::size() const
+    { return count; }
+
+    bool PositionDatabase::probe(const quint64& position, quint64& value) const
+    {
+        // Binary search for the first entry that isn't smaller than the position
+        // The value bits don't matter: all entries of the position lie between (position << 2) and (position << 2) + 3
+        const quint64 key = position << 2;
+        int low = 0;
+        int high = count;
+        while(low < high)
+        {
+            const int middle = low + (high - low) / 2;
+            if(entry(middle) < key)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+
+        // Check if the position is found
+        if(low == count || (entry(low) >> 2) != position)
+            return false;
+
+        value = decodeValue(entry(low) & 3);
+        return true;
+    }
+
+// Private:
+    quint64 PositionDatabase::entry(const int& index) const
+    { return file != 0 ? qFromLittleEndian(entries[index]) : entries[index]; }
@@ -0,0 +1,92 @@
+/************************************************************************
+* This file is part of IntelliCon.                                      *
+*                                                                       *
+* IntelliCon is free software: you can redistribute it and/or modify    *
+* it under the terms of the GNU General Public License as published by  *
+* the Free Software Foundation, either version 3 of the License, or     *
+* (at your option) any later version.                                   *
+*                                                                       *
+* IntelliCon is distributed in the hope that it will be useful,         *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+* GNU General Public License for more details.                          *
+*                                                                       *
+* You should have received a copy of the GNU General Public License     *
+* along with IntelliCon.  If not, see <http://www.gnu.org/licenses/>.   *
+************************************************************************/
+
+#ifndef POSITIONDATABASE_H
+#define POSITIONDATABASE_H
+
+#include <QtGlobal>
+#include <QString>
+#include <vector>
+
+class QFile;
+
+/** PositionDatabase: a set of positions of which the game theoretical value is known
+  The positions are BoardInts, only the symmetric twin with the lowest value is stored (see "positions database format.txt").
+  The values are the game theoretical values as used by AlphaBetaSearcher (Loss, Draw or Win), without any depth.
+
+  Every entry is one 64-bit integer: the position shifted 2 bits to the left, the lowest 2 bits hold the value.
+  The entries are sorted, so a position is found by a binary search.
+
+  The database can be loaded in two ways:
+  - From a packed file, which is mapped in memory as a whole. No parsing is needed and processes that map
+    the same file share its memory.
+    The packed file starts with a header of 16 bytes: the magic "ICPOSDB" followed by a zero byte,
+    the format version (quint32) and the amount of entries (quint32). The sorted entries follow the header.
+    All integers are stored in little endian byte order.
+  - From the three files of the original format (win-pos.db, draw-pos.db and loss-pos.db), which are read and sorted.
+
+  A database can also be built by inserting positions and sorting them (this is how intellicon-bookgen builds its books).
+  Once loaded, the database may be read by multiple threads at once.
+**/
+class PositionDatabase
+{
+    public:
+        PositionDatabase();
+        ~PositionDatabase();
+
+        // Maps the given packed file in memory, returns false if the file can't be mapped or isn't a valid packed file
+        bool map(const QString& fileName);
+        // Reads the win, draw and loss files that start with the given prefix (e.g. ":/data/" reads ":/data/win-pos.db" etc.)
+        // Returns false if any of the files can't be read
+        bool loadFiles(const QString& prefix);
+        // Adds a position with the given value, sort() has to be called before the database is used
+        // If the database is mapped, the mapped positions are copied first
+        void insert(const quint64& position, const quint64& value);
+        // Sorts the positions, a position that's inserted more than once keeps its lowest value
+        void sort();
+        // Writes the database to a packed file, returns false if the file can't be written
+        bool save(const QString& fileName) const;
+        // Removes all positions
+        void clear();
+
+        // Whether any positions are loaded
+        bool isLoaded() const;
+        // Whether the positions are read from a mapped file
+        bool isMapped() const;
+        // The amount of positions
+        int size() const;
+
+        // Looks up the given position (which should already be the lowest of the symmetric twins)
+        // Returns true and sets value if the position is found
+        bool probe(const quint64& position, quint64& value) const;
+
+    private:
+        QFile* file;                    // The mapped file, 0 if the entries aren't mapped
+        const uchar* mapped;            // The mapped memory
+        std::vector<quint64> owned;     // The entries if they're read from the original files
+        const quint64* entries;         // Points to the sorted entries (either in the mapped memory or in owned)
+        int count;                      // The amount of entries
+
+        // Returns the entry at the given index
+        quint64 entry(const int& index) const;
+
+        // Disable copying
+        PositionDatabase(const PositionDatabase&);
+        PositionDatabase& operator=(const PositionDatabase&);
+};
+
+#endif // POSITIONDATABASE_H
@@ -0,0 +1,314 @@
+/************************************************************************
+* This file is part of IntelliCon.                                      *
+*                                                                       *
+* IntelliCon is free software: you can redistribute it and/or modify    *
+* it under the terms of the GNU General Public License as published by  *
+* the Free Software Foundation, either version 3 of the License, or     *
+* (at your option) any later version.                                   *
+*                                                                       *
+* IntelliCon is distributed in the hope that it will be useful,         *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+* GNU General Public License for more details.                          *
+*                                                                       *
+* You should have received a copy of the GNU General Public License     *
+* along with IntelliCon.  If not, see <http://www.gnu.org/licenses/>.   *
+************************************************************************/
+
+#include "solver.h"
+#include <QMutexLocker>
+
+// Public:
+    Solver::Result::Result()
+    : bestMove(-1), value(AlphaBetaSearcher::ValueUnknown)
+    {
+        for(int col = 0; col < 7; ++col)
+        {
+            moveValues[col] = AlphaBetaSearcher::ValueUnknown;
+            moveScores[col] = 0;
+            completeVariations[col] = false;
+        }
+    }
+
+    Solver::Solver()
+    : depthLimit(0), threadCount(QThreadPool::globalInstance()->maxThreadCount()), exactValues(false), distanceScores(false), nullWindow(false), board(0)
+    {
+        // Make sure the position database is available
+        if(!AlphaBetaSearcher::positionDatabaseLoaded())
+            AlphaBetaSearcher::loadPositionDatabase();
+    }
+
+    void Solver::setDepthLimit(const int& depth)
+    { depthLimit = depth; }
+
+    void Solver::setThreadCount(const int& threads)
+    {
+        threadCount = qMax(1, threads);
+
+        // Make sure the thread pool can run all searchers at once, otherwise helpers would wait for other searchers to finish
+        if(QThreadPool::globalInstance()->maxThreadCount() < threadCount)
+            QThreadPool::globalInstance()->setMaxThreadCount(threadCount);
+    }
+
+    void Solver::setExactValues(const bool& enabled)
+    { exactValues = enabled; }
+
+    void Solver::setDistanceScores(const bool& enabled)
+    { distanceScores = enabled; }
+
+    void Solver::setNullWindow(const bool& enabled)
+    { nullWindow = enabled; }
+
+    Solver::Result Solver::solve(const BitBoard& board)
+    {
+        result = Result();
+        this->board = board;
+
+        // If the game has already ended, there is nothing to solve
+        if(board.redHasWon() || board.yellowHasWon() || board.isFull())
+        {
+            result.value = board.redHasWon() ? AlphaBetaSearcher::Win : (board.yellowHasWon() ? AlphaBetaSearcher::Loss : AlphaBetaSearcher::Draw);
+            return result;
+        }
+
+        // If we can win directly, we don't have to search at all
+        // Unless the values of all columns are needed, then only the winning columns don't have to be searched
+        // The columns after which the opponent can win directly lose in one ply, these aren't searched either,
+        // since the searchers expect that the player to move can't win directly (AlphaBetaSearcher::findMoves() never allows it)
+        const bool redToMove = board.redToMove();
+        int decidedLine[7][2];      // The line of play of the columns that aren't searched, -1 if the column is searched
+        for(int col = 0; col < 7; ++col)
+        {
+            decidedLine[col][0] = decidedLine[col][1] = -1;
+            if(!board.canMove(col)) continue;
+
+            const BitBoard newBoard(board.move(col));
+            if(redToMove ? newBoard.redHasWon() : newBoard.yellowHasWon())
+            {
+                result.moveValues[col] = AlphaBetaSearcher::createPositionValue(redToMove ? AlphaBetaSearcher::Win : AlphaBetaSearcher::Loss, 0);
+                decidedLine[col][0] = col;
+                if(exactValues) continue;
+
+                result.bestMove = col;
+                result.value = AlphaBetaSearcher::createPositionValue(AlphaBetaSearcher::getValue(result.moveValues[col]), 1);
+                result.principalVariations[col].push_back(col);
+                result.completeVariations[col] = true;
+                return result;
+            }
+
+            for(int reply = 0; reply < 7; ++reply)
+            {
+                if(!newBoard.canMove(reply)) continue;
+
+                const BitBoard replyBoard(newBoard.move(reply));
+                if(redToMove ? replyBoard.yellowHasWon() : replyBoard.redHasWon())
+                {
+                    result.moveValues[col] = AlphaBetaSearcher::createPositionValue(redToMove ? AlphaBetaSearcher::Loss : AlphaBetaSearcher::Win, 1);
+                    decidedLine[col][0] = col;
+                    decidedLine[col][1] = reply;
+                    break;
+                }
+            }
+        }
+
+        // Start a searcher for each playable column, the remaining threads are used by helpers
+        {
+            QMutexLocker locker(&resultsLocker);
+            rootBound = redToMove ? AlphaBetaSearcher::Loss : AlphaBetaSearcher::Win;
+            int started = 0;
+            for(int col = 0; col < 7; ++col)
+            {
+                columnKeepRunning[col] = board.canMove(col) && decidedLine[col][0] == -1;
+                columnSolved[col] = !columnKeepRunning[col];
+                columnSearchers[col] = 0;
+                searchersStarted[col] = 0;
+                scoreDepths[col] = 0;
+            }
+            for(int col = 0; col < 7; ++col)
+            {
+                if(columnSolved[col]) continue;
+
+                startSearcher(col);
+                ++started;
+            }
+            startHelpers(threadCount - started);
+        }
+
+        // Wait for all searchers to report their result (and for the stopped helpers to quit)
+        QThreadPool::globalInstance()->waitForDone();
+
+        // Choose the best move
+        chooseBestMove();
+
+        // The columns share the value they're sure of, so a column that isn't better than the best one may only get a bound
+        // If the best column is such a bound too (e.g. a Draw that's only at most a Draw), the value of the position isn't known
+        // The best column is solved again with exact values then, until the best column has an exact value
+        // This ends, since a column that's solved again has an exact value afterwards
+        // The depth limited searches are left alone, solving a column completely would take far longer than they're meant to
+        while(depthLimit == 0 && (AlphaBetaSearcher::getValue(result.value) == AlphaBetaSearcher::DrawWin ||
+                                  AlphaBetaSearcher::getValue(result.value) == AlphaBetaSearcher::DrawLoss))
+        {
+            result.moveValues[result.bestMove] = solveExactly(result.bestMove);
+            chooseBestMove();
+        }
+
+        // Follow the best moves stored in the transposition table to find the expected line of play of each column
+        for(int col = 0; col < 7; ++col)
+        {
+            if(!board.canMove(col)) continue;
+
+            if(decidedLine[col][0] != -1)
+            {
+                for(int i = 0; i < 2 && decidedLine[col][i] != -1; ++i)
+                    result.principalVariations[col].push_back(decidedLine[col][i]);
+                result.completeVariations[col] = true;
+                continue;
+            }
+
+            result.principalVariations[col].push_back(col);
+
+            const std::vector<int> pv = AlphaBetaSearcher::principalVariation(BitBoard(board.move(col)), result.completeVariations[col]);
+            result.principalVariations[col].insert(result.principalVariations[col].end(), pv.begin(), pv.end());
+        }
+
+        return result;
+    }
+
+    bool Solver::movesToBoard(const std::string& moves, quint64& board)
+    {
+        BitBoard bitBoard(0);
+        for(std::string::const_iterator pos = moves.begin(); pos != moves.end(); ++pos)
+        {
+            // Only the columns 1 to 7 exist
+            const int col = *pos - '1';
+            if(col < 0 || col >= 7) return false;
+
+            // The move should be possible and the game shouldn't have ended yet
+            if(!bitBoard.canMove(col) || bitBoard.redHasWon() || bitBoard.yellowHasWon()) return false;
+
+            bitBoard.setBitBoard(bitBoard.move(col));
+        }
+
+        board = bitBoard.toInt();
+        return true;
+    }
+
+// Private:
+    void Solver::chooseBestMove()
+    {
+        // Choose the best move, just like PerfectPlayerThread does:
+        // An unknown value is still better than a loss, if the values are equal we win as fast as possible or lose as slow as possible
+        // Of the moves with an unknown value we choose the one with the best score
+        const bool redToMove = board.redToMove();
+        int bestRank = -1;
+        result.bestMove = -1;
+        for(int col = 0; col < 7; ++col)
+        {
+            if(!board.canMove(col)) continue;
+
+            const AlphaBetaSearcher::PositionValue val = AlphaBetaSearcher::getValue(result.moveValues[col]);
+            const int rank = val == AlphaBetaSearcher::ValueUnknown ? 2 * AlphaBetaSearcher::Loss + 1 : 2 * (redToMove ? val : AlphaBetaSearcher::Win + AlphaBetaSearcher::Loss - val);
+            const bool winning = val == (redToMove ? AlphaBetaSearcher::Win : AlphaBetaSearcher::Loss);
+            const quint16 depth = AlphaBetaSearcher::getDepth(result.moveValues[col]);
+            const quint16 bestDepth = result.bestMove == -1 ? 0 : AlphaBetaSearcher::getDepth(result.moveValues[result.bestMove]);
+            if(rank > bestRank || (rank == bestRank && (val == AlphaBetaSearcher::ValueUnknown ? betterScore(col, result.bestMove, redToMove)
+                                                                                                : (winning ? depth < bestDepth : depth > bestDepth))))
+            {
+                bestRank = rank;
+                result.bestMove = col;
+            }
+        }
+
+        // The value of the position is that of the best move, one ply further away from the end of the game
+        if(result.bestMove != -1)
+            result.value = AlphaBetaSearcher::createPositionValue(AlphaBetaSearcher::getValue(result.moveValues[result.bestMove]),
+                                                                  1 + AlphaBetaSearcher::getDepth(result.moveValues[result.bestMove]));
+    }
+
+    AlphaBetaSearcher::PositionValue Solver::solveExactly(const int& col)
+    {
+        // Search in this thread with the full window and without the root bound, the bounds in the transposition table aren't trusted
+        AlphaBetaSearcher searcher(BitBoard(board.move(col)), col);
+        searcher.setExactValues(true);
+        const AlphaBetaSearcher::PositionValue val = searcher.alphaBeta(MaskBoard(board.move(col)), AlphaBetaSearcher::Loss, AlphaBetaSearcher::Win);
+        result.statistics += searcher.statistics();
+        return val;
+    }
+
+    bool Solver::betterScore(const int& col, const int& bestCol, const bool& redToMove) const
+    {
+        // Only called when the ranks are equal, so a best column has been chosen already
+        Q_ASSERT(bestCol != -1);
+        return redToMove ? result.moveScores[col] > result.moveScores[bestCol] : result.moveScores[col] < result.moveScores[bestCol];
+    }
+
+    void Solver::startSearcher(const int& col)
+    {
+        AlphaBetaSearcher* searcher = new AlphaBetaSearcher(BitBoard(board.move(col)), col);
+        searcher->setInterruptedPointer(&columnKeepRunning[col]);
+        searcher->setDepthLimit(depthLimit);
+        searcher->setHelperIndex(searchersStarted[col]++);
+        searcher->setExactValues(exactValues);
+        searcher->setDistanceScores(distanceScores);
+        searcher->setNullWindow(nullWindow);
+        if(!exactValues)
+            searcher->setRootBound(&rootBound, board.redToMove());
+        connect(searcher, SIGNAL(done(const int&, const quint16&, const AlphaBetaSearcher::Statistics&)),
+                this, SLOT(searcherDone(const int&, const quint16&, const AlphaBetaSearcher::Statistics&)), Qt::DirectConnection);
+        connect(searcher, SIGNAL(iterationDone(const int&, const int&, const int&)),
+                this, SLOT(searcherIterationDone(const int&, const int&, const int&)), Qt::DirectConnection);
+        QThreadPool::globalInstance()->start(searcher);    // QThreadPool will clean up the searcher when it's done
+        ++columnSearchers[col];
+    }
+
+    void Solver::startHelpers(int count)
+    {
+        // Give the helpers to the columns with the fewest searchers first
+        while(count > 0)
+        {
+            int helpCol = -1;
+            for(int col = 0; col < 7; ++col)
+            {
+                if(!columnSolved[col] && (helpCol == -1 || columnSearchers[col] < columnSearchers[helpCol]))
+                    helpCol = col;
+            }
+            if(helpCol == -1) return;
+
+            startSearcher(helpCol);
+            --count;
+        }
+    }
+
+// Private slots:
+    void Solver::searcherDone(const int& col, const quint16& val, const AlphaBetaSearcher::Statistics& stats)
+    {
+        QMutexLocker locker(&resultsLocker);
+
+        // Only the first searcher of a column to finish counts, its helpers are stopped
+        if(columnSolved[col]) return;
+        columnSolved[col] = true;
+        columnKeepRunning[col] = false;
+        // The searches by depth or by distance don't use the root bound, their values are exact
+        const bool boundUsed = !exactValues && depthLimit == 0 && !distanceScores;
+        result.moveValues[col] = boundUsed ? AlphaBetaSearcher::rootMoveValue(rootBound, val, board.redToMove()) : val;
+        result.statistics += stats;
+
+        // The other columns only have to prove whether they're better than this one
+        AlphaBetaSearcher::raiseRootBound(rootBound, result.moveValues[col], board.redToMove());
+
+        // The threads of this column can help the other columns now
+        const int freed = columnSearchers[col];
+        columnSearchers[col] = 0;
+        startHelpers(freed);
+    }
+
+    void Solver::searcherIterationDone(const int& col, const int& depth, const int& score)
+    {
+        // The searchers of a column may be at different iterations, the deepest one counts
+        QMutexLocker locker(&resultsLocker);
+        if(!columnSolved[col] && depth >= scoreDepths[col])
+        {
+            result.moveScores[col] = score;
+            scoreDepths[col] = depth;
+        }
+    }
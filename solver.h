@@ -0,0 +1,118 @@
+/************************************************************************
+* This file is part of IntelliCon.                                      *
+*                                                                       *
+* IntelliCon is free software: you can redistribute it and/or modify    *
+* it under the terms of the GNU General Public License as published by  *
+* the Free Software Foundation, either version 3 of the License, or     *
+* (at your option) any later version.                                   *
+*                                                                       *
+* IntelliCon is distributed in the hope that it will be useful,         *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+* GNU General Public License for more details.                          *
+*                                                                       *
+* You should have received a copy of the GNU General Public License     *
+* along with IntelliCon.  If not, see <http://www.gnu.org/licenses/>.   *
+************************************************************************/
+
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <QObject>
+#include <QMutex>
+#include <QThreadPool>
+#include <QAtomicInt>
+#include <QMetaType>
+#include <vector>
+#include "bitboard.h"
+#include "alphabetasearcher.h"
+
+// Solves positions without the need of an event loop, used by the command line tools
+// For every playable column an AlphaBetaSearcher is started in the global QThreadPool, solve() blocks until all of them are done
+// If more threads may be used than there are columns, helpers search the same columns (see AlphaBetaSearcher::setHelperIndex())
+// When a column is solved its helpers are stopped and the freed threads start helping the columns that aren't solved yet
+// The searchers share the value of the columns that are solved, so the other columns only have to prove whether they're better
+// Note that this means the value of a column that isn't the best move may only be a bound (e.g. DrawLoss instead of Loss),
+// unless exact values are asked for (see setExactValues())
+class Solver : public QObject
+{
+    Q_OBJECT
+
+    public:
+        /// The result of solving a position
+        /// Note that all values are seen from red's point of view (just like the values of AlphaBetaSearcher)
+        struct Result
+        {
+            int bestMove;                               // The best column to play, -1 if no move can be played
+            AlphaBetaSearcher::PositionValue value;     // The value of the position when bestMove is played, its depth includes bestMove itself
+                                                        // (with distance scores it's the distance of the position to the end of the game)
+            AlphaBetaSearcher::PositionValue moveValues[7];     // The value of each column, ValueUnknown if the column can't be played
+                                                                // Without exact values, a column that isn't better than the best one may only have a bound
+            AlphaBetaSearcher::Statistics statistics;   // The summed statistics of the searches of all columns
+            int moveScores[7];                          // The score of each column found by the last iteration of a depth limited search
+            std::vector<int> principalVariations[7];    // The expected line of play of each column, starting with the column itself
+            bool completeVariations[7];                 // Whether the line of play of each column reaches the end of the game,
+                                                        // otherwise it stops at a position of which the best move isn't known
+
+            Result();
+        };
+
+        Solver();
+
+        // Sets the maximum depth of the searches, 0 (the default) means every position is solved completely
+        // If a depth is set, columns of which the value stays unknown are compared using the scores of the depth limited search
+        void setDepthLimit(const int& depth);
+        // Sets the amount of searchers that run at the same time, by default the maximum thread count of the global QThreadPool
+        void setThreadCount(const int& threads);
+        // Sets whether the value of every column should be exact, instead of only the value of the best move (disabled by default)
+        // The columns don't share the value they're sure of then and bounds in the transposition table aren't used,
+        // so the search takes longer, this is meant for analysing positions (see AlphaBetaSearcher::setExactValues())
+        void setExactValues(const bool& enabled);
+        // Sets whether the columns are solved by the exact distance to the end of the game (see AlphaBetaSearcher::setDistanceScores())
+        // The best move then wins as fast as possible or loses as slow as possible (disabled by default)
+        void setDistanceScores(const bool& enabled);
+        // Sets whether the columns are solved by a sequence of null-window searches (see AlphaBetaSearcher::setNullWindow())
+        void setNullWindow(const bool& enabled);
+
+        // Finds the best move and the value of the given position
+        Result solve(const BitBoard& board);
+
+        // Converts a string of moves to a board, the columns are numbered 1 to 7 (so "44" means both players played in the middle column)
+        // Returns false if the string contains an invalid or illegal move
+        static bool movesToBoard(const std::string& moves, quint64& board);
+
+    private:
+        int depthLimit;                                 // The depth limit given to the searchers
+        int threadCount;                                // The amount of searchers that run at the same time
+        bool exactValues;                               // Whether the value of every column should be exact
+        bool distanceScores;                            // Whether the columns are solved by the exact distance to the end of the game
+        bool nullWindow;                                // Whether the columns are solved by a sequence of null-window searches
+        BitBoard board;                                 // The position that's being solved
+        bool columnKeepRunning[7];                      // Whether the searchers of each column should keep searching
+        bool columnSolved[7];                           // Whether a searcher of each column has reported its result
+        int columnSearchers[7];                         // The amount of searchers working on each column
+        int searchersStarted[7];                        // The amount of searchers started for each column, used as helper index
+        int scoreDepths[7];                             // The depth of the iteration that gave the score in result.moveScores
+        QAtomicInt rootBound;                           // The value the player to move is already sure of, shared by all searchers
+        QMutex resultsLocker;                           // Lock for the results and the searcher administration, the searchers report from their own threads
+        Result result;                                  // The result that's being filled by the searchers
+
+        // Sets the best move and the value of the result, according to the values (and the scores) of the columns
+        void chooseBestMove();
+        // Solves the given column again with exact values, in the calling thread, and returns its value
+        // The statistics of the search are added to the result
+        AlphaBetaSearcher::PositionValue solveExactly(const int& col);
+        // Whether the score of the given column, found by the last iteration of a depth limited search, is better than the score of bestCol
+        bool betterScore(const int& col, const int& bestCol, const bool& redToMove) const;
+        // Starts a searcher for the given column, resultsLocker should be locked
+        void startSearcher(const int& col);
+        // Starts the given amount of searchers, divided over the columns that aren't solved yet, resultsLocker should be locked
+        void startHelpers(int count);
+
+    private slots:
+        void searcherDone(const int& col, const quint16& val, const AlphaBetaSearcher::Statistics& stats);
+        void searcherIterationDone(const int& col, const int& depth, const int& score);
+};
+Q_DECLARE_METATYPE(Solver::Result)
+
+#endif // SOLVER_H
@@ -0,0 +1,341 @@
+/************************************************************************
+* This file is part of IntelliCon.                                      *
+*                                                                       *
+* IntelliCon is free software: you can redistribute it and/or modify    *
+* it under the terms of the GNU General Public License as published by  *
+* the Free Software Foundation, either version 3 of the License, or     *
+* (at your option) any later version.                                   *
+*                                                                       *
+* IntelliCon is distributed in the hope that it will be useful,         *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+* GNU General Public License for more details.                          *
+*                                                                       *
+* You should have received a copy of the GNU General Public License     *
+* along with IntelliCon.  If not, see <http://www.gnu.org/licenses/>.   *
+************************************************************************/
+
+#include <QCoreApplication>
+#include <QStringList>
+#include <QFile>
+#include <QTextStream>
+#include <QElapsedTimer>
+#include "solver.h"
+
+// Prints how this program should be used
+void printUsage(QTextStream& out)
+{
+    out<<"Usage: intellicon-solver [options] [file...]"<<endl
+       <<"Solves every position read from the given files (or from stdin if no files are given), one position per line."<<endl
+       <<"A position is a sequence of moves, the columns are numbered 1 to 7 (e.g. 4453)."<<endl
+       <<"For every position a line is printed with: the position, the best move, the value for the player to move and the depth."<<endl
+       <<"A position may be followed by its exact value for the player to move (win, draw or loss, e.g. 4453 draw), positions that get"<<endl
+       <<"another value (a bound like atleast-draw included) are reported and the exit code is 1 then (see solver/regression.txt)."<<endl
+       <<"With --distance the value of a win or a loss may be followed by the distance to the end of the game in plies too (e.g. 661453711113 loss 18),"<<endl
+       <<"which is checked the same way (see solver/distances.txt)."<<endl
+       <<endl
+       <<"Options:"<<endl
+       <<"  --bitboard                  Read the positions as BitBoard integers instead of move sequences"<<endl
+       <<"  --tt-size <MB>              The size of the transposition table in megabytes (default: 64)"<<endl
+       <<"  --depth <n>                 Search at most n plies deep using iterative deepening (default: solve completely)"<<endl
+       <<"  --pv                        Also print the expected line of play, starting with the best move"<<endl
+       <<"                              A line that stops before the end of the game because the best move isn't known ends with ..."<<endl
+       <<"  --analyse                   Find the exact value of every column, a line is printed for each column after the line of the position"<<endl
+       <<"                              with: the column, the value, the depth and the expected line of play"<<endl
+       <<"  --distance                  Solve by the exact distance to the end of the game, so wins are as fast and losses as slow as possible"<<endl
+       <<"  --null-window               Solve every column with null-window searches (is it better than a loss, is it a win) instead of the full window"<<endl
+       <<"  --threads <n>               The amount of searchers that run at the same time (default: the amount of cores)"<<endl
+       <<"  --position-db <file>        Map the given packed 8-ply position database instead of the default one"<<endl
+       <<"  --write-position-db <file>  Write the 8-ply position database to a packed file and exit"<<endl
+       <<"  --book <n> <file>           Use the opening book with the values of positions with n (10 or 12) pieces"<<endl
+       <<"  --cache <file>              Keep the positions that took a lot of work in the given file, for later runs"<<endl
+       <<"  --cache-size <n>            The maximum amount of positions in the cache file (default: 1048576)"<<endl
+       <<"  --help                      Show this help"<<endl;
+}
+
+// Returns the value as a string, seen from the point of view of the player to move
+QString valueToString(const AlphaBetaSearcher::PositionValue& val, const bool& redToMove)
+{
+    const AlphaBetaSearcher::PositionValue value = AlphaBetaSearcher::getValue(val);
+    if(value == AlphaBetaSearcher::Loss)        return redToMove ? "loss" : "win";
+    if(value == AlphaBetaSearcher::DrawLoss)    return redToMove ? "atmost-draw" : "atleast-draw";
+    if(value == AlphaBetaSearcher::Draw)        return "draw";
+    if(value == AlphaBetaSearcher::DrawWin)     return redToMove ? "atleast-draw" : "atmost-draw";
+    if(value == AlphaBetaSearcher::Win)         return redToMove ? "win" : "loss";
+    return "unknown";
+}
+
+// Prints a line of play as a sequence of moves, a line that doesn't reach the end of the game ends with "..."
+void printLine(QTextStream& out, const std::vector<int>& line, const bool& complete)
+{
+    for(unsigned int i = 0; i < line.size(); ++i)
+        out<<line[i] + 1;
+    if(!complete)
+        out<<"...";
+}
+
+// Solves all positions read from the input stream, returns the amount of positions solved or -1 on an error
+// The statistics of all searches are added to stats, the amount of positions that don't have their expected value is added to mismatches
+// If printPv is true the expected line of play is printed too, if analyse is true the value of every column is printed too
+// If distance is true the positions are solved by distance, so the expected distances are checked too
+int solveStream(QTextStream& in, QTextStream& out, QTextStream& err, Solver& solver, const bool& readBitBoards, const bool& printPv, const bool& analyse,
+                const bool& distance, AlphaBetaSearcher::Statistics& stats, int& mismatches)
+{
+    int solved = 0;
+    while(!in.atEnd())
+    {
+        // Skip empty lines and comments
+        const QStringList fields = in.readLine().trimmed().split(' ', QString::SkipEmptyParts);
+        if(fields.isEmpty() || fields[0].startsWith("#")) continue;
+        const QString& line = fields[0];
+
+        // Read the position
+        quint64 boardInt = 0;
+        bool ok = true;
+        if(readBitBoards)
+            boardInt = line.toULongLong(&ok, 0);
+        else
+            ok = Solver::movesToBoard(line.toStdString(), boardInt);
+
+        // Read the expected distance
+        int expectedDistance = -1;
+        if(ok && fields.size() == 3)
+            ok = (expectedDistance = fields[2].toInt(&ok)) >= 0 && ok;
+
+        if(!ok || fields.size() > 3)
+        {
+            err<<"Invalid position: "<<fields.join(" ")<<endl;
+            return -1;
+        }
+
+        // Solve the position
+        const BitBoard board(boardInt);
+        const Solver::Result result = solver.solve(board);
+
+        // Print the result, the best move is printed as a column from 1 to 7 (or - if no move can be played)
+        out<<line<<' '
+           <<(result.bestMove == -1 ? QString("-") : QString::number(result.bestMove + 1))<<' '
+           <<valueToString(result.value, board.redToMove())<<' '
+           <<AlphaBetaSearcher::getDepth(result.value);
+        if(printPv && result.bestMove != -1)
+        {
+            out<<' ';
+            printLine(out, result.principalVariations[result.bestMove], result.completeVariations[result.bestMove]);
+        }
+        out<<endl;
+
+        // Compare the value with the expected value, and the distance with the expected distance if it's known
+        if(fields.size() >= 2 && valueToString(result.value, board.redToMove()) != fields[1])
+        {
+            err<<"Position "<<line<<" should be "<<fields[1]<<", but is "<<valueToString(result.value, board.redToMove())<<endl;
+            ++mismatches;
+        }
+        else if(distance && expectedDistance != -1 && AlphaBetaSearcher::getDepth(result.value) != expectedDistance)
+        {
+            err<<"Position "<<line<<" should end in "<<expectedDistance<<" plies, but ends in "<<AlphaBetaSearcher::getDepth(result.value)<<" plies"<<endl;
+            ++mismatches;
+        }
+
+        // Print the value of every column, indented so they can be told apart from the positions
+        for(int col = 0; analyse && col < 7; ++col)
+        {
+            if(!board.canMove(col)) continue;
+
+            out<<"  "<<col + 1<<' '
+               <<valueToString(result.moveValues[col], board.redToMove())<<' '
+               <<AlphaBetaSearcher::getDepth(result.moveValues[col])<<' ';
+            printLine(out, result.principalVariations[col], result.completeVariations[col]);
+            out<<endl;
+        }
+        stats += result.statistics;
+        ++solved;
+
+        // Write the positions found while solving this position to the cache file
+        if(!AlphaBetaSearcher::flushPositionCache())
+            err<<"Could not write the cache file"<<endl;
+    }
+    return solved;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    // Parse the arguments
+    bool readBitBoards = false;
+    bool printPv = false;
+    bool analyse = false;
+    bool distance = false;
+    bool nullWindow = false;
+    int depthLimit = 0;
+    int threadCount = 0;
+    QString cacheFile;
+    int cacheSize = 1 << 20;
+    QStringList files;
+    const QStringList args = app.arguments();
+    for(int i = 1; i < args.size(); ++i)
+    {
+        if(args[i] == "--help" || args[i] == "-h")
+        {
+            printUsage(out);
+            return 0;
+        }
+        else if(args[i] == "--bitboard")
+            readBitBoards = true;
+        else if(args[i] == "--pv")
+            printPv = true;
+        else if(args[i] == "--analyse")
+            analyse = true;
+        else if(args[i] == "--distance")
+            distance = true;
+        else if(args[i] == "--null-window")
+            nullWindow = true;
+        else if(args[i] == "--tt-size" && i + 1 < args.size())
+        {
+            bool ok = false;
+            const int megabytes = args[++i].toInt(&ok);
+            if(!ok || megabytes <= 0)
+            {
+                err<<"Invalid transposition table size: "<<args[i]<<endl;
+                return 1;
+            }
+            AlphaBetaSearcher::setTranspositionTableSize(megabytes);
+        }
+        else if(args[i] == "--position-db" && i + 1 < args.size())
+            AlphaBetaSearcher::setPositionDatabaseFile(args[++i]);
+        else if(args[i] == "--write-position-db" && i + 1 < args.size())
+        {
+            const QString fileName = args[++i];
+            if(!AlphaBetaSearcher::savePositionDatabase(fileName))
+            {
+                err<<"Could not write "<<fileName<<endl;
+                return 1;
+            }
+            return 0;
+        }
+        else if(args[i] == "--book" && i + 2 < args.size())
+        {
+            const int pieces = args[++i].toInt();
+            const QString fileName = args[++i];
+            if(!AlphaBetaSearcher::loadOpeningBook(pieces, fileName))
+            {
+                err<<"Could not load the "<<pieces<<"-ply book "<<fileName<<endl;
+                return 1;
+            }
+        }
+        else if(args[i] == "--threads" && i + 1 < args.size())
+        {
+            bool ok = false;
+            threadCount = args[++i].toInt(&ok);
+            if(!ok || threadCount <= 0)
+            {
+                err<<"Invalid thread count: "<<args[i]<<endl;
+                return 1;
+            }
+        }
+        else if(args[i] == "--cache" && i + 1 < args.size())
+            cacheFile = args[++i];
+        else if(args[i] == "--cache-size" && i + 1 < args.size())
+        {
+            bool ok = false;
+            cacheSize = args[++i].toInt(&ok);
+            if(!ok || cacheSize <= 0)
+            {
+                err<<"Invalid cache size: "<<args[i]<<endl;
+                return 1;
+            }
+        }
+        else if(args[i] == "--depth" && i + 1 < args.size())
+        {
+            bool ok = false;
+            depthLimit = args[++i].toInt(&ok);
+            if(!ok || depthLimit <= 0)
+            {
+                err<<"Invalid depth: "<<args[i]<<endl;
+                return 1;
+            }
+        }
+        else if(args[i].startsWith("-") && args[i] != "-")
+        {
+            printUsage(err);
+            return 1;
+        }
+        else
+            files<<args[i];
+    }
+
+    // Open the cache file after the transposition table has its final size, since the cached positions are put in it
+    if(!cacheFile.isEmpty())
+    {
+        if(!AlphaBetaSearcher::openPositionCache(cacheFile, cacheSize))
+        {
+            err<<"Could not open the cache file "<<cacheFile<<endl;
+            return 1;
+        }
+        err<<"Loaded "<<AlphaBetaSearcher::positionCacheSize()<<" positions from "<<cacheFile<<endl;
+    }
+
+    // Solve all positions
+    Solver solver;
+    solver.setDepthLimit(depthLimit);
+    solver.setExactValues(analyse);
+    solver.setDistanceScores(distance);
+    solver.setNullWindow(nullWindow);
+    if(threadCount > 0)
+        solver.setThreadCount(threadCount);
+    QElapsedTimer timer;
+    timer.start();
+    int solved = 0;
+    int mismatches = 0;
+    AlphaBetaSearcher::Statistics stats;
+    if(files.isEmpty())
+        files<<"-";
+    for(QStringList::const_iterator pos = files.begin(); pos != files.end(); ++pos)
+    {
+        int result;
+        if(*pos == "-")
+        {
+            QTextStream in(stdin);
+            result = solveStream(in, out, err, solver, readBitBoards, printPv, analyse, distance, stats, mismatches);
+        }
+        else
+        {
+            QFile file(*pos);
+            if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+            {
+                err<<"Could not open "<<*pos<<endl;
+                return 1;
+            }
+            QTextStream in(&file);
+            result = solveStream(in, out, err, solver, readBitBoards, printPv, analyse, distance, stats, mismatches);
+        }
+
+        if(result == -1)
+            return 1;
+        solved += result;
+    }
+
+    // Report the throughput
+    const qint64 elapsed = timer.elapsed();
+    err<<"Solved "<<solved<<" positions in "<<elapsed<<" ms";
+    if(elapsed > 0)
+        err<<" ("<<QString::number(1000.0 * solved / elapsed, 'f', 1)<<" positions/s)";
+    err<<endl;
+
+    // Report where the search spent its time
+    err<<"Searched "<<stats.nodes<<" nodes";
+    if(elapsed > 0)
+        err<<" ("<<QString::number(static_cast<double>(stats.nodes) / elapsed, 'f', 1)<<" knodes/s)";
+    err<<", "<<stats.cutoffs<<" cutoffs ("<<QString::number(stats.firstMoveCutoffRate(), 'f', 1)<<"% by the first move), "
+       <<stats.forcedMoves<<" forced moves, "<<stats.threatLosses<<" threat losses"<<endl;
+    err<<"Transposition table: "<<stats.tableHits<<" hits in "<<stats.tableProbes<<" probes, position database: "<<stats.hits[8]<<" hits"<<endl;
+
+    if(mismatches > 0)
+    {
+        err<<mismatches<<" positions don't have their expected value"<<endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,19 @@
+#-------------------------------------------------
+#
+# Command line solver: solves positions without a display
+#
+#-------------------------------------------------
+
+QT       += core
+QT       -= gui
+
+TARGET = intellicon-solver
+TEMPLATE = app
+CONFIG   += console
+CONFIG   -= app_bundle
+
+include(../engine.pri)
+
+SOURCES += main.cpp
+
+OTHER_FILES += regression.txt
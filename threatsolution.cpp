@@ -16,41 +16,34 @@
 ************************************************************************/
 
 #include "linethreat.h"
+#include <QtGlobal>
 #include <algorithm>
 
 // ThreatSolution:
     // Public:
         ThreatSolution::ThreatSolution(const Type& type)
-        : type(type), dontUse(false), win(false)
+        : type(type), index(0), squaresUsed(0), usedSquares(0), usedCols(0), specialCols(0), win(false)
         {
-            switch(type)
-            {
-                case ClaimEven:         squares.reserve(2); break;
-                case BaseInverse:       squares.reserve(2); break;
-                case Vertical:          squares.reserve(2); break;
-                case AfterEven:         squares.reserve(8); break;
-                case LowInverse:        squares.reserve(4); break;
-                case HighInverse:       squares.reserve(6); break;
-                case BaseClaim:         squares.reserve(4); break;
-                case Before:            squares.reserve(8); break;
-                case SpecialBefore:     squares.reserve(9); break;
-                case AfterBaseInverse:  squares.reserve(2); break;
-                case AfterVertical:     squares.reserve(2); break;
-            }
+            // The most squares used by each type are:
+            //   ClaimEven, BaseInverse, Vertical, AfterBaseInverse and AfterVertical: 2
+            //   LowInverse and BaseClaim: 4, HighInverse: 6, AfterEven and Before: 8, SpecialBefore: 9 (MaxSquares)
 
             // Some types will always win the game
             if(type == AfterEven || type == AfterBaseInverse || type == AfterVertical)
                 makeGameWinner();
         }
 
+        ThreatSolution::~ThreatSolution()
+        {}
+
         bool ThreatSolution::operator==(const ThreatSolution& other) const
         {
             if(other.type == Before || other.type == SpecialBefore)
                 return other.operator==(*this);
 
-            if(type != other.type || squares.size() != other.squares.size()) return false;
+            if(type != other.type || squaresUsed != other.squaresUsed) return false;
 
-            for(unsigned int i = 0; i < squares.size(); ++i)
+            for(unsigned int i = 0; i < squaresUsed; ++i)
             {
                 if(squares[i] != other[i]) return false;
             }
@@ -68,117 +61,73 @@
         { return squares[n]; }
 
         unsigned int ThreatSolution::squareCount() const
-        { return squares.size(); }
+        { return squaresUsed; }
 
         void ThreatSolution::addSquare(const PieceCoords& square)
         {
-            for(std::vector<PieceCoords>::iterator pos = squares.begin(); pos != squares.end(); ++pos)
-            {
-                if(square.col < pos->col)
-                {
-                    squares.insert(pos, square);
-                    return;
-                }
-                else if(square.col == pos->col)
-                {
-                    if(square.row < pos->row)
-                    {
-                        squares.insert(pos, square);
-                        return;
-                    }
-                    else if(square.row == pos->row)
-                        return;
-                }
-            }
-
-            // The square wasn't inserted, so we add it to the back
-            squares.push_back(square);
+            // Find the place of the square, a square that's already used isn't added again
+            unsigned int place = 0;
+            while(place < squaresUsed && (squares[place].col < square.col || (squares[place].col == square.col && squares[place].row < square.row)))
+                ++place;
+            if(place < squaresUsed && squares[place] == square)
+                return;
+
+            // The squares are stored in the solution itself, a solution that needs more than MaxSquares squares
+            // would write past them, so this is checked in release builds as well
+            if(squaresUsed == MaxSquares)
+                qFatal("ThreatSolution::addSquare(): a solution of type %d uses more than %u squares", static_cast<int>(type), MaxSquares);
+
+            // Move the squares after it one place up
+            for(unsigned int i = squaresUsed; i > place; --i)
+                squares[i] = squares[i - 1];
+            squares[place] = square;
+            ++squaresUsed;
+            usedSquares |= Q_UINT64_C(1) << (square.row + 7 * square.col);
+            usedCols |= 1 << square.col;
         }
         void ThreatSolution::addSquare(const int& col, const int& row)
         { addSquare(PieceCoords(col, row)); }
 
+        quint64 ThreatSolution::squareMask() const
+        { return usedSquares; }
+        quint8 ThreatSolution::columnMask() const
+        { return usedCols; }
+        quint8 ThreatSolution::squaresInCol(const int& col) const
+        { return (usedSquares >> (7 * col)) & 0x3F; }
+
         bool ThreatSolution::winsGame() const
         { return win; }
         void ThreatSolution::makeGameWinner()
         { win = true; }
 
         bool ThreatSolution::interferes(const ThreatSolution* other) const
-        {
-            std::vector<PieceCoords>::const_iterator pos = squares.begin();
-            std::vector<PieceCoords>::const_iterator pos2 = other->squares.begin();
-
-            while(pos != squares.end() && pos2 != other->squares.end())
-            {
-                if(pos->col == pos2->col)
-                {
-                    if(pos->row == pos2->row)       return true;
-                    else if(pos->row < pos2->row)   ++pos;
-                    else                            ++pos2;
-                }
-                else if(pos->col < pos2->col)
-                    ++pos;
-                else
-                    ++pos2;
-            }
-
-            return false;
-        }
+        { return (usedSquares & other->usedSquares) != 0; }
 
         bool ThreatSolution::interferesColumnWise(const ThreatSolution* other) const
         {
-            // Check if one of the 2 solutions is a Before or SpecialBefore and can therefore have special squares
-            const ThreatSolutionBefore* thisBefore = dynamic_cast<const ThreatSolutionBefore*>(this);
-            const ThreatSolutionBefore* otherBefore = dynamic_cast<const ThreatSolutionBefore*>(other);
-
-            // Which columns are used by this solution
-            bool colUsed[7] = {false, false, false, false, false, false, false};
-            // Which squares are used by this solution
-            bool squareUsed[7][6] = {{false, false, false, false, false, false},
-                                     {false, false, false, false, false, false},
-                                     {false, false, false, false, false, false},
-                                     {false, false, false, false, false, false},
-                                     {false, false, false, false, false, false},
-                                     {false, false, false, false, false, false},
-                                     {false, false, false, false, false, false}};
-
-            // Fill the colUsed and squareUsed arrays
-            for(std::vector<PieceCoords>::const_iterator pos = squares.begin(); pos != squares.end(); ++pos)
-            {
-                colUsed[pos->col] = true;
-                squareUsed[pos->col][pos->row] = true;
-            }
+            // Only the columns used by both solutions can interfere
+            if((usedSquares & other->usedSquares) == 0) return false;
 
-            // Check the filled arrays against the squares of the other solution
-            int currCol = -1;
-            bool squaresDisjoint = true;
-            bool squaresEqual = true;
-            for(std::vector<PieceCoords>::const_iterator pos = other->squares.begin(); pos != other->squares.end(); ++pos)
+            const quint8 sharedCols = usedCols & other->usedCols;
+            for(int col = 0; col < 7; ++col)
             {
-                if(!colUsed[pos->col]) continue;
-
-                if(pos->col != currCol)
-                {
-                    if(!squaresDisjoint && !squaresEqual) return true;
-                    currCol = pos->col;
-                    squaresDisjoint = true;
-                    squaresEqual = true;
-                    if(thisBefore != 0 && thisBefore->isSpecialSquareColumn(currCol))
-                        squaresEqual = false;
-                    if(otherBefore != 0 && otherBefore->isSpecialSquareColumn(currCol))
-                        squaresEqual = false;
-                }
-
-                if(!squareUsed[pos->col][pos->row]) squaresEqual = false;
-                else                                squaresDisjoint = false;
+                if(!(sharedCols & (1 << col))) continue;
+
+                // The squares in this column interfere if they're not disjoint, unless the squares of the other solution are also used by this one
+                // If special squares are used in this column, the squares must be disjoint
+                const quint8 these = squaresInCol(col);
+                const quint8 others = other->squaresInCol(col);
+                if((these & others) != 0 && ((others & ~these) != 0 || ((specialCols | other->specialCols) & (1 << col))))
+                    return true;
             }
 
-            return !squaresDisjoint && !squaresEqual;
+            return false;
         }
 
 // ThreatSolutionBefore:
     // Public:
         ThreatSolutionBefore::ThreatSolutionBefore(const Type& type)
-        : ThreatSolution(type), claimEvenUsed(7, false), specialSquareCols(7, false) {}
+        : ThreatSolution(type), claimEvenCols(0) {}
 
         bool ThreatSolutionBefore::operator==(const ThreatSolution& other) const
         {
@@ -187,30 +136,28 @@
             const ThreatSolutionBefore* before = dynamic_cast<const ThreatSolutionBefore*>(&other);
             if(before == 0) return false;
 
-            for(unsigned int col = 0; col < 7;  ++col)
-            {
-                if(claimEvenUsed[col] != before->claimEvenUsed[col]) return false;
-            }
-
-            return true;
+            return claimEvenCols == before->claimEvenCols;
         }
 
         void ThreatSolutionBefore::useClaimEvenIn(const int& col)
-        { claimEvenUsed[col] = true; }
+        { claimEvenCols |= 1 << col; }
         bool ThreatSolutionBefore::claimEvenUsedInCol(const int& col) const
-        { return claimEvenUsed[col]; }
+        { return claimEvenCols & (1 << col); }
+        quint8 ThreatSolutionBefore::claimEvenColumns() const
+        { return claimEvenCols; }
 
         int ThreatSolutionBefore::lowestUsedSquareInCol(const int& col) const
         {
-            for(std::vector<PieceCoords>::const_iterator pos = squares.begin(); pos != squares.end(); ++pos)
-            {
-                if(pos->col == col) return pos->row;
-            }
+            const quint8 rows = squaresInCol(col);
+            if(rows == 0) return -1;
 
-            return -1;
+            int row = 0;
+            while(!(rows & (1 << row)))
+                ++row;
+            return row;
         }
 
         void ThreatSolutionBefore::addSpecialSquareColumn(const int& col)
-        { specialSquareCols[col] = true; }
+        { specialCols |= 1 << col; }
         bool ThreatSolutionBefore::isSpecialSquareColumn(const int& col) const
-        { return specialSquareCols[col]; }
+        { return specialCols & (1 << col); }
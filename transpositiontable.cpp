@@ -0,0 +1,127 @@
+/************************************************************************
+* This file is part of IntelliCon.                                      *
+*                                                                       *
+* IntelliCon is free software: you can redistribute it and/or modify    *
+* it under the terms of the GNU General Public License as published by  *
+* the Free Software Foundation, either version 3 of the License, or     *
+* (at your option) any later version.                                   *
+*                                                                       *
+* IntelliCon is distributed in the hope that it will be useful,         *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+* GNU General Public License for more details.                          *
+*                                                                       *
+* You should have received a copy of the GNU General Public License     *
+* along with IntelliCon.  If not, see <http://www.gnu.org/licenses/>.   *
+************************************************************************/
+
+#include "transpositiontable.h"
+
+// The lowest 48 bits of a data word contain the data, the highest 16 bits the priority
+static const quint64 dataMask = (Q_UINT64_C(1) << 48) - 1;
+
+// Public:
+    TranspositionTable::TranspositionTable(const int& megabytes)
+    : memory(0), buckets(0), bucketMask(0), megabytes(0)
+    { resize(megabytes); }
+
+    TranspositionTable::~TranspositionTable()
+    { delete[] memory; }
+
+    void TranspositionTable::resize(const int& megabytes)
+    {
+        // Free the old table
+        delete[] memory;
+
+        // Find the largest power of two amount of buckets that fits in the requested size (but use at least one bucket)
+        const quint64 maxBuckets = static_cast<quint64>(qMax(1, megabytes)) * 1024 * 1024 / sizeof(Bucket);
+        quint64 bucketCount = 1;
+        while(bucketCount * 2 <= maxBuckets)
+            bucketCount *= 2;
+
+        // Allocate the table, aligned at a cache line so every bucket is exactly one cache line
+        memory = new char[bucketCount * sizeof(Bucket) + 63];
+        buckets = reinterpret_cast<Bucket*>((reinterpret_cast<quintptr>(memory) + 63) & ~static_cast<quintptr>(63));
+        bucketMask = bucketCount - 1;
+        this->megabytes = megabytes;
+
+        // Start with an empty table
+        clear();
+    }
+
+    void TranspositionTable::clear()
+    {
+        for(quint64 i = 0; i <= bucketMask; ++i)
+        {
+            for(int j = 0; j < BucketSize; ++j)
+            {
+                buckets[i].entries[j].check = 0;
+                buckets[i].entries[j].data = 0;
+            }
+        }
+    }
+
+    int TranspositionTable::size() const
+    { return megabytes; }
+
+    bool TranspositionTable::probe(const quint64& key, quint64& data) const
+    {
+        const Bucket& bucket = bucketFor(key);
+        for(int i = 0; i < BucketSize; ++i)
+        {
+            // Read both words only once, another thread may be writing them at this moment
+            const quint64 entryData = bucket.entries[i].data;
+            const quint64 entryCheck = bucket.entries[i].check;
+
+            // An empty entry has a data word of 0
+            // If the entry is (partly) overwritten by another thread, the check won't match
+            if(entryData != 0 && (entryCheck ^ entryData) == key)
+            {
+                data = entryData & dataMask;
+                return true;
+            }
+        }
+
+        // The key wasn't found
+        return false;
+    }
+
+    void TranspositionTable::store(const quint64& key, const quint64& data, const quint16& priority)
+    {
+        const quint64 newData = (data & dataMask) | (static_cast<quint64>(priority) << 48);
+
+        // Find the entry to replace: the entry with the same key if it exists, otherwise the one with the lowest priority
+        // Note that empty entries have the lowest possible priority
+        Bucket& bucket = bucketFor(key);
+        Entry* replace = &bucket.entries[0];
+        quint16 lowestPriority = bucket.entries[0].data >> 48;
+        for(int i = 0; i < BucketSize; ++i)
+        {
+            const quint64 entryData = bucket.entries[i].data;
+            const quint64 entryCheck = bucket.entries[i].check;
+
+            // Always overwrite an older result for the same key
+            if(entryData != 0 && (entryCheck ^ entryData) == key)
+            {
+                replace = &bucket.entries[i];
+                break;
+            }
+
+            if(static_cast<quint16>(entryData >> 48) < lowestPriority)
+            {
+                replace = &bucket.entries[i];
+                lowestPriority = entryData >> 48;
+            }
+        }
+
+        // Write the entry, a reader that sees only one of the two words will reject the entry
+        replace->data = newData;
+        replace->check = key ^ newData;
+    }
+
+// Private:
+    TranspositionTable::Bucket& TranspositionTable::bucketFor(const quint64& key) const
+    {
+        // Multiplying by 2^64 divided by the golden ratio spreads the bits of the key over the highest bits of the product
+        return buckets[((key * Q_UINT64_C(0x9E3779B97F4A7C15)) >> 32) & bucketMask];
+    }
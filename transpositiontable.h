@@ -0,0 +1,87 @@
+/************************************************************************
+* This file is part of IntelliCon.                                      *
+*                                                                       *
+* IntelliCon is free software: you can redistribute it and/or modify    *
+* it under the terms of the GNU General Public License as published by  *
+* the Free Software Foundation, either version 3 of the License, or     *
+* (at your option) any later version.                                   *
+*                                                                       *
+* IntelliCon is distributed in the hope that it will be useful,         *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+* GNU General Public License for more details.                          *
+*                                                                       *
+* You should have received a copy of the GNU General Public License     *
+* along with IntelliCon.  If not, see <http://www.gnu.org/licenses/>.   *
+************************************************************************/
+
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+#include <QtGlobal>
+
+/** TranspositionTable: a fixed-size hash table that can be shared by multiple threads without locking
+  The table consists of a power of two number of buckets, each bucket is exactly one cache line (64 bytes) and holds 4 entries.
+  A key is mapped to a bucket, within that bucket the key may be stored in any of the 4 entries.
+
+  Every entry consists of two 64-bit words: the data and the key XOR-ed with the data.
+  Readers and writers don't lock anything, so a reader may see an entry that's only half written by another thread.
+  Such an entry is detected since the check word XOR-ed with the data word won't result in the key anymore,
+  in that case the entry is simply ignored (as if the key wasn't found).
+
+  The highest 16 bits of the data word are reserved for the priority of the entry.
+  If all entries in a bucket are occupied, the entry with the lowest priority is replaced.
+  The remaining 48 bits can be used freely.
+**/
+class TranspositionTable
+{
+    public:
+        // Creates a table that uses (at most) the given amount of megabytes
+        TranspositionTable(const int& megabytes);
+        ~TranspositionTable();
+
+        // Reallocates the table so it uses (at most) the given amount of megabytes, all entries are lost
+        // Warning: this may not be called while other threads are using the table
+        void resize(const int& megabytes);
+        // Removes all entries from the table
+        // Warning: this may not be called while other threads are using the table
+        void clear();
+        // Returns the amount of megabytes the table uses
+        int size() const;
+
+        // Looks up the given key, returns true and sets data if the key is found
+        // The priority bits are stripped from the data
+        bool probe(const quint64& key, quint64& data) const;
+        // Stores data (at most 48 bits) for the given key, using the given priority for the replacement scheme
+        void store(const quint64& key, const quint64& data, const quint16& priority);
+
+    private:
+        // Note that the words are volatile so the compiler will always read and write them as a whole
+        struct Entry
+        {
+            volatile quint64 check;     // The key XOR-ed with the data
+            volatile quint64 data;      // The priority (highest 16 bits) and the data (lowest 48 bits)
+        };
+
+        // The amount of entries per bucket
+        static const int BucketSize = 4;
+
+        struct Bucket
+        {
+            Entry entries[BucketSize];
+        };
+
+        char* memory;                   // The allocated memory (buckets points into this memory at a cache line boundary)
+        Bucket* buckets;                // The buckets of the table
+        quint64 bucketMask;             // The amount of buckets minus one (the amount of buckets is a power of two)
+        int megabytes;                  // The amount of megabytes that was requested for this table
+
+        // Returns the bucket the given key belongs to
+        Bucket& bucketFor(const quint64& key) const;
+
+        // Disable copying
+        TranspositionTable(const TranspositionTable&);
+        TranspositionTable& operator=(const TranspositionTable&);
+};
+
+#endif // TRANSPOSITIONTABLE_H